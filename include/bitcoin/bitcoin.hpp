@@ -23,6 +23,7 @@
 #include <bitcoin/bitcoin/settings.hpp>
 #include <bitcoin/bitcoin/version.hpp>
 #include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/block_view.hpp>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/chain/compact.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
@@ -37,6 +38,7 @@
 #include <bitcoin/bitcoin/chain/script.hpp>
 #include <bitcoin/bitcoin/chain/stealth_record.hpp>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/chain/transaction_view.hpp>
 #include <bitcoin/bitcoin/chain/witness.hpp>
 #include <bitcoin/bitcoin/config/authority.hpp>
 #include <bitcoin/bitcoin/config/base16.hpp>
@@ -92,14 +94,18 @@
 #include <bitcoin/bitcoin/machine/script_pattern.hpp>
 #include <bitcoin/bitcoin/machine/script_version.hpp>
 #include <bitcoin/bitcoin/machine/sighash_algorithm.hpp>
+#include <bitcoin/bitcoin/machine/stack_element.hpp>
 #include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/math/crypto.hpp>
 #include <bitcoin/bitcoin/math/ec_point.hpp>
 #include <bitcoin/bitcoin/math/ec_scalar.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/golomb_coding.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
+#include <bitcoin/bitcoin/math/murmur3.hpp>
 #include <bitcoin/bitcoin/math/ring_signature.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
 #include <bitcoin/bitcoin/math/stealth.hpp>
 #include <bitcoin/bitcoin/math/uint256.hpp>
 #include <bitcoin/bitcoin/message/address.hpp>
@@ -107,6 +113,7 @@
 #include <bitcoin/bitcoin/message/alert_payload.hpp>
 #include <bitcoin/bitcoin/message/block.hpp>
 #include <bitcoin/bitcoin/message/block_transactions.hpp>
+#include <bitcoin/bitcoin/message/bloom_filter.hpp>
 #include <bitcoin/bitcoin/message/compact_block.hpp>
 #include <bitcoin/bitcoin/message/fee_filter.hpp>
 #include <bitcoin/bitcoin/message/filter_add.hpp>
@@ -131,8 +138,10 @@
 #include <bitcoin/bitcoin/message/pong.hpp>
 #include <bitcoin/bitcoin/message/prefilled_transaction.hpp>
 #include <bitcoin/bitcoin/message/reject.hpp>
+#include <bitcoin/bitcoin/message/rolling_filter.hpp>
 #include <bitcoin/bitcoin/message/send_compact.hpp>
 #include <bitcoin/bitcoin/message/send_headers.hpp>
+#include <bitcoin/bitcoin/message/stream_decoder.hpp>
 #include <bitcoin/bitcoin/message/transaction.hpp>
 #include <bitcoin/bitcoin/message/verack.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
@@ -149,6 +158,8 @@
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/atomic.hpp>
 #include <bitcoin/bitcoin/utility/binary.hpp>
+#include <bitcoin/bitcoin/utility/buffer_pool.hpp>
+#include <bitcoin/bitcoin/utility/checksum_writer.hpp>
 #include <bitcoin/bitcoin/utility/collection.hpp>
 #include <bitcoin/bitcoin/utility/color.hpp>
 #include <bitcoin/bitcoin/utility/conditional_lock.hpp>
@@ -205,6 +216,7 @@
 #include <bitcoin/bitcoin/wallet/message.hpp>
 #include <bitcoin/bitcoin/wallet/mini_keys.hpp>
 #include <bitcoin/bitcoin/wallet/mnemonic.hpp>
+#include <bitcoin/bitcoin/wallet/neutrino.hpp>
 #include <bitcoin/bitcoin/wallet/payment_address.hpp>
 #include <bitcoin/bitcoin/wallet/qrcode.hpp>
 #include <bitcoin/bitcoin/wallet/select_outputs.hpp>
@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_CHAIN_BLOCK_HPP
 #define LIBBITCOIN_CHAIN_BLOCK_HPP
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <istream>
@@ -36,6 +37,7 @@
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
 namespace libbitcoin {
@@ -98,7 +100,7 @@ public:
     bool from_data(std::istream& stream, bool witness=false);
     bool from_data(reader& source, bool witness=false);
 
-    bool is_valid() ;
+    bool is_valid() const;
 
     // Serialization.
     //-------------------------------------------------------------------------
@@ -114,14 +116,16 @@ public:
     size_t serialized_size(bool witness=false) const;
 
     chain::header& header();
-    void set_header(chain::header& value);
+    const chain::header& header() const;
+    void set_header(const chain::header& value);
     void set_header(chain::header&& value);
 
-     transaction::list& transactions() ;
-    void set_transactions(transaction::list& value);
+    transaction::list& transactions();
+    const transaction::list& transactions() const;
+    void set_transactions(const transaction::list& value);
     void set_transactions(transaction::list&& value);
 
-    hash_digest hash() ;
+    hash_digest hash() const;
 
     // Utilities.
     //-------------------------------------------------------------------------
@@ -142,7 +146,7 @@ public:
     uint64_t claim() ;
     uint64_t reward(size_t height, uint64_t subsidy_interval,
         uint64_t initial_block_subsidy_satoshi) ;
-    hash_digest generate_merkle_root(bool witness=false) ;
+    hash_digest generate_merkle_root(bool witness=false) const;
     size_t signature_operations() ;
     size_t signature_operations(bool bip16, bool bip141) ;
     size_t total_non_coinbase_inputs() ;
@@ -163,7 +167,13 @@ public:
 
     code check(uint64_t max_money, uint32_t timestamp_limit_seconds,
         uint32_t proof_of_work_limit, bool scrypt=false) ;
+
+    /// Transaction checks, hashing and sigop counting run on the pool.
+    /// The result is the same as that of the serial check.
+    code check(uint64_t max_money, uint32_t timestamp_limit_seconds,
+        uint32_t proof_of_work_limit, threadpool& pool, bool scrypt=false) ;
     code check_transactions(uint64_t max_money) ;
+    code check_transactions(uint64_t max_money, threadpool& pool) ;
     code accept( settings& settings, bool transactions=true,
         bool header=true) ;
     code accept(const chain_state& state,  settings& settings,
@@ -179,11 +189,26 @@ public:
 protected:
     void reset();
 
+    /// Discard cached values and advance the revision.
+    void invalidate_cache() const;
+
+    /// Advanced on every modification, so that a derived cache can detect
+    /// that it is stale without a virtual call.
+    uint32_t revision() const;
+
 private:
     typedef boost::optional<size_t> optional_size;
+    typedef std::vector<code> code_list;
 
     optional_size total_inputs_cache() const;
     optional_size non_coinbase_inputs_cache() const;
+    optional_size base_size_cache() const;
+    optional_size total_size_cache() const;
+
+    code check_structure(uint32_t timestamp_limit_seconds,
+        uint32_t proof_of_work_limit, bool scrypt) ;
+    code check_transaction_set() ;
+    code_list check_each_transaction(uint64_t max_money, threadpool& pool) ;
 
     chain::header header_;
     transaction::list transactions_;
@@ -192,9 +217,12 @@ private:
     mutable boost::optional<bool> segregated_;
     mutable optional_size total_inputs_;
     mutable optional_size non_coinbase_inputs_;
-    mutable boost::optional<size_t> base_size_;
-    mutable boost::optional<size_t> total_size_;
+    mutable optional_size base_size_;
+    mutable optional_size total_size_;
     mutable upgrade_mutex mutex_;
+
+    // This is atomic, not guarded by the mutex.
+    mutable std::atomic<uint32_t> revision_;
 };
 
 } // namespace chain
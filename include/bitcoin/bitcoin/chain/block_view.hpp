@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_BLOCK_VIEW_HPP
+#define LIBBITCOIN_CHAIN_BLOCK_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/transaction_view.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+/// A read-only view of a wire-encoded block over a caller-owned buffer.
+/// The buffer must outlive the view. Transaction boundaries are indexed on
+/// construction, transactions are indexed or deserialized only on access.
+class BC_API block_view
+{
+public:
+    typedef std::vector<size_t> offsets;
+
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    block_view();
+
+    block_view(block_view&& other);
+    block_view(const block_view& other);
+
+    block_view(data_slice data);
+
+    // Operators.
+    //-------------------------------------------------------------------------
+
+    block_view& operator=(block_view&& other);
+    block_view& operator=(const block_view& other);
+
+    // Deserialization.
+    //-------------------------------------------------------------------------
+
+    /// Index the block, which must span the full data.
+    bool from_data(data_slice data);
+
+    bool is_valid() const;
+
+    // Properties (size, accessors).
+    //-------------------------------------------------------------------------
+
+    /// The wire encoding of the block (with witness if present).
+    data_slice data() const;
+
+    size_t serialized_size() const;
+
+    /// Deserialize the header from the leading bytes.
+    chain::header header() const;
+
+    /// Hash the header bytes.
+    hash_digest hash() const;
+
+    size_t transactions_size() const;
+
+    /// Raw wire encoding of the indexed transaction (with witness).
+    data_slice transaction_data(size_t index) const;
+
+    /// Index the transaction (its elements are not deserialized).
+    transaction_view transaction(size_t index) const;
+
+    /// Hash each transaction from the underlying bytes.
+    hash_list to_hashes(bool witness=false) const;
+
+    /// Deserialize the full block.
+    block to_block(bool witness=true) const;
+
+protected:
+    void reset();
+
+private:
+    const uint8_t* begin_;
+    size_t size_;
+    offsets transactions_;
+};
+
+} // namespace chain
+} // namespace libbitcoin
+
+#endif
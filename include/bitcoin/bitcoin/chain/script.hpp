@@ -24,6 +24,7 @@
 #include <istream>
 #include <memory>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/error.hpp>
@@ -51,6 +52,30 @@ public:
     typedef machine::script_pattern script_pattern;
     typedef machine::script_version script_version;
 
+    /// An operation parsed in place, with its payload referenced by position
+    /// within the script bytes. A trailing invalid token marks a parse failure.
+    struct token
+    {
+        typedef std::vector<token> list;
+
+        machine::opcode code;
+        uint32_t offset;
+        uint32_t size;
+        bool valid;
+    };
+
+    /// A conditional operation and its matching else or endif, by position,
+    /// with the number of counted operations between them.
+    struct branch
+    {
+        typedef std::vector<branch> list;
+
+        size_t from;
+        size_t to;
+        size_t counted;
+        bool skippable;
+    };
+
     // Constructors.
     //-------------------------------------------------------------------------
 
@@ -125,6 +150,27 @@ public:
     size_t serialized_size(bool prefix) const;
     const operation::list& operations() const;
 
+    /// Parsed without copying push data, for use in place of operations.
+    const token::list& tokens() const;
+
+    /// Conditional branch targets, matched with the operations and ordered
+    /// by position.
+    const branch::list& branches() const;
+
+    /// The push data of a token of this script (not copied).
+    data_slice payload(const token& token) const;
+
+    /// The script serialization, without prefix (not copied).
+    data_slice bytes() const;
+
+    // Classification (static).
+    //-------------------------------------------------------------------------
+
+    /// Classify encoded script bytes in place, without parsing operations.
+    static script_pattern classify_output(data_slice bytes);
+    static script_pattern classify_input(data_slice bytes);
+    static script_version classify_version(data_slice bytes);
+
     // Signing.
     //-------------------------------------------------------------------------
 
@@ -134,7 +180,7 @@ public:
         uint64_t value=max_uint64);
 
     static bool check_signature(const ec_signature& signature,
-        uint8_t sighash_type, const data_chunk& public_key,
+        uint8_t sighash_type, data_slice public_key,
         const script& script_code, const transaction& tx, uint32_t input_index,
         script_version version=script_version::unversioned,
         uint64_t value=max_uint64);
@@ -166,7 +212,6 @@ public:
     static bool is_commitment_pattern(const operation::list& ops);
     static bool is_witness_program_pattern(const operation::list& ops);
 
-
     /// Common output patterns (psh and pwsh are also consensus).
     static bool is_pay_null_data_pattern(const operation::list& ops);
     static bool is_pay_multisig_pattern(const operation::list& ops);
@@ -201,6 +246,11 @@ public:
     script_pattern input_pattern() const;
     script_pattern output_pattern() const;
 
+    /// The hash, public key or data of a pay_key_hash, pay_script_hash,
+    /// pay_public_key or pay_null_data output, or the witness program of a
+    /// versioned script, otherwise empty (not copied).
+    data_slice output_payload() const;
+
     /// Consensus computations.
     size_t sigops(bool accurate) const;
     void find_and_delete(const data_stack& endorsements);
@@ -216,6 +266,15 @@ public:
     static code verify(const transaction& tx, uint32_t input_index,
         uint32_t forks, const script& prevout_script, uint64_t value);
 
+    /// Verify by evaluation only (the reference for verify_standard).
+    static code verify_program(const transaction& tx, uint32_t input_index,
+        uint32_t forks, const script& prevout_script, uint64_t value);
+
+    /// Verify p2pkh, p2wpkh, p2sh-p2wpkh and p2wsh multisig without
+    /// evaluation. True implies verify success, false requires evaluation.
+    static bool verify_standard(const transaction& tx, uint32_t input_index,
+        uint32_t forks, const script& prevout_script, uint64_t value);
+
 protected:
     // So that input and output may call reset from their own.
     friend class input;
@@ -227,6 +286,13 @@ protected:
 
 private:
     static size_t serialized_size(const operation::list& ops);
+    static size_t count_sigops(const token::list& tokens, bool accurate);
+    static script_pattern classify_output(const token::list& tokens,
+        data_slice bytes);
+    static script_pattern classify_input(const token::list& tokens,
+        data_slice bytes);
+    static script_version classify_version(const token::list& tokens);
+    static branch::list match_branches(const operation::list& ops);
     static data_chunk operations_to_data(const operation::list& ops);
     static hash_digest generate_unversioned_signature_hash(
         const transaction& tx, uint32_t input_index,
@@ -235,14 +301,22 @@ private:
         uint32_t input_index, const script& script_code, uint64_t value,
         uint8_t sighash_type);
 
-    void find_and_delete_(const data_chunk& endorsement);
-
     operation::list& operations_move();
     const operation::list& operations_copy() const;
+    token::list& tokens_move();
+    const token::list& tokens_copy() const;
 
     // These are protected by mutex.
     mutable operation::list operations_;
     mutable bool cached_;
+    mutable token::list tokens_;
+    mutable bool tokenized_;
+    mutable branch::list branches_;
+    mutable size_t legacy_sigops_;
+    mutable size_t accurate_sigops_;
+    mutable script_pattern output_pattern_;
+    mutable script_pattern input_pattern_;
+    mutable script_version version_;
     mutable upgrade_mutex mutex_;
 
     data_chunk bytes_;
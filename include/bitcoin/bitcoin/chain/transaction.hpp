@@ -19,6 +19,8 @@
 #ifndef LIBBITCOIN_CHAIN_TRANSACTION_HPP
 #define LIBBITCOIN_CHAIN_TRANSACTION_HPP
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <istream>
@@ -206,16 +208,31 @@ public:
 
 protected:
     void reset();
-    void invalidate_cache() const;
     bool all_inputs_final() const;
 
+    /// Discard cached hashes and advance the revision.
+    void invalidate_cache() const;
+
+    /// Advanced on every modification, so that a derived cache can detect
+    /// that it is stale without a virtual call.
+    uint32_t revision() const;
+
 private:
     typedef std::shared_ptr<hash_digest> hash_ptr;
     typedef boost::optional<uint64_t> optional_value;
+    typedef boost::optional<size_t> optional_size;
+    typedef std::array<optional_size, 4> sigops_array;
+
+    static size_t serialized_size(const input::list& inputs,
+        const output::list& outputs, uint32_t version, uint32_t locktime,
+        bool wire, bool witness);
 
     hash_ptr hash_cache() const;
     optional_value total_input_value_cache() const;
     optional_value total_output_value_cache() const;
+    sigops_array sigops_cache() const;
+    optional_size base_size_cache() const;
+    optional_size total_size_cache() const;
 
     uint32_t version_;
     uint32_t locktime_;
@@ -233,7 +250,13 @@ private:
     // These share a mutex as they are not expected to contend.
     mutable optional_value total_input_value_;
     mutable optional_value total_output_value_;
+    mutable sigops_array sigops_;
+    mutable optional_size base_size_;
+    mutable optional_size total_size_;
     mutable boost::optional<bool> segregated_;
+
+    // This is atomic, not guarded by either mutex.
+    mutable std::atomic<uint32_t> revision_;
     mutable upgrade_mutex mutex_;
 };
 
@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_TRANSACTION_VIEW_HPP
+#define LIBBITCOIN_CHAIN_TRANSACTION_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/input.hpp>
+#include <bitcoin/bitcoin/chain/output.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+/// A read-only view of a wire-encoded transaction over a caller-owned buffer.
+/// The buffer must outlive the view. Input and output boundaries are indexed
+/// on construction, elements are deserialized only when accessed.
+class BC_API transaction_view
+{
+public:
+    typedef std::vector<size_t> offsets;
+
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    transaction_view();
+
+    transaction_view(transaction_view&& other);
+    transaction_view(const transaction_view& other);
+
+    transaction_view(data_slice data);
+
+    // Operators.
+    //-------------------------------------------------------------------------
+
+    transaction_view& operator=(transaction_view&& other);
+    transaction_view& operator=(const transaction_view& other);
+
+    // Deserialization.
+    //-------------------------------------------------------------------------
+
+    /// Index the transaction at the front of data, which may be followed by
+    /// other data (such as subsequent block transactions).
+    bool from_data(data_slice data);
+
+    /// The wire size of the transaction at the front of data, zero if invalid.
+    static size_t measure(data_slice data);
+
+    bool is_valid() const;
+
+    // Properties (size, accessors).
+    //-------------------------------------------------------------------------
+
+    /// The wire encoding of the transaction (with witness if present).
+    data_slice data() const;
+
+    size_t serialized_size(bool witness=false) const;
+    bool is_segregated() const;
+
+    uint32_t version() const;
+    uint32_t locktime() const;
+
+    size_t inputs_size() const;
+    size_t outputs_size() const;
+
+    /// Raw wire encodings of the indexed element (without witness).
+    data_slice input_data(size_t index) const;
+    data_slice output_data(size_t index) const;
+
+    /// Output properties read in place.
+    uint64_t output_value(size_t index) const;
+    data_slice output_script(size_t index) const;
+
+    /// Deserialize the indexed element (witness is populated if present).
+    chain::input input(size_t index) const;
+    chain::output output(size_t index) const;
+
+    /// Hash the underlying bytes (the witness hash of a coinbase is not null).
+    hash_digest hash(bool witness=false) const;
+
+    /// Deserialize the full transaction.
+    transaction to_transaction(bool witness=true) const;
+
+protected:
+    void reset();
+
+private:
+    static size_t parse(const uint8_t* begin, const uint8_t* end,
+        offsets* inputs, offsets* outputs, offsets* witnesses);
+
+    const uint8_t* begin_;
+    size_t size_;
+    offsets inputs_;
+    offsets outputs_;
+    offsets witnesses_;
+};
+
+} // namespace chain
+} // namespace libbitcoin
+
+#endif
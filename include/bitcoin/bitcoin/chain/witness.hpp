@@ -22,9 +22,11 @@
 #include <cstddef>
 #include <istream>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/chain/script.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
+#include <bitcoin/bitcoin/machine/stack_element.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
@@ -33,11 +35,29 @@
 namespace libbitcoin {
 namespace chain {
 
+/// Elements are stored in a single buffer, indexed by their end offsets.
 class BC_API witness
 {
 public:
     typedef machine::operation operation;
-    typedef data_stack::const_iterator iterator;
+    typedef std::vector<size_t> offsets;
+
+    /// Forward iteration over the elements as slices of the witness buffer.
+    class BC_API iterator
+    {
+    public:
+        iterator(const witness& owner, size_t index);
+
+        data_slice operator*() const;
+        iterator& operator++();
+        iterator operator++(int);
+        bool operator==(const iterator& other) const;
+        bool operator!=(const iterator& other) const;
+
+    private:
+        const witness* owner_;
+        size_t index_;
+    };
 
     // Constructors.
     //-------------------------------------------------------------------------
@@ -94,17 +114,19 @@ public:
     void clear();
     bool empty() const;
     size_t size() const;
-    const data_chunk& front() const;
-    const data_chunk& back() const;
+    data_slice front() const;
+    data_slice back() const;
     iterator begin() const;
     iterator end() const;
-    const data_chunk& operator[](size_t index) const;
+    data_slice operator[](size_t index) const;
 
     // Properties (size, accessors, cache).
     //-------------------------------------------------------------------------
 
     size_t serialized_size(bool prefix) const;
-    const data_stack& stack() const;
+
+    /// Copy the elements (use iteration or indexing to avoid the copy).
+    data_stack stack() const;
 
     // Utilities.
     //-------------------------------------------------------------------------
@@ -112,9 +134,14 @@ public:
     static bool is_push_size(const data_stack& stack);
     static bool is_reserved_pattern(const data_stack& stack);
 
+    /// The first count elements are within the push size limit.
+    bool is_push_size(size_t count) const;
+    bool is_reserved_pattern() const;
+
     bool extract_sigop_script(script& out_script,
         const script& program_script) const;
-    bool extract_embedded_script(script& out_script, data_stack& out_stack,
+    bool extract_embedded_script(script& out_script,
+        machine::stack_element::list& out_stack,
         const script& program_script) const;
 
     // Validation.
@@ -130,11 +157,14 @@ protected:
     void reset();
 
 private:
-    static size_t serialized_size(const data_stack& stack);
     static operation::list to_pay_key_hash(data_chunk&& program);
 
+    void assign(const data_stack& stack);
+    void push_back(data_slice element);
+
     bool valid_;
-    data_stack stack_;
+    data_chunk data_;
+    offsets offsets_;
 };
 
 } // namespace chain
@@ -21,6 +21,7 @@
 
 #include <cstdint>
 #include <utility>
+#include <vector>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
 #include <bitcoin/bitcoin/chain/script.hpp>
 #include <bitcoin/bitcoin/define.hpp>
@@ -30,6 +31,7 @@
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
 #include <bitcoin/bitcoin/machine/program.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 
@@ -59,7 +61,7 @@ inline interpreter::result interpreter::op_reserved(opcode)
 inline interpreter::result interpreter::op_push_number(program& program,
     uint8_t value)
 {
-    program.push_move({ value });
+    program.push_move(program::value_type{ value });
     return error::success;
 }
 
@@ -233,8 +235,8 @@ inline interpreter::result interpreter::op_rot2(program& program)
     const auto position_5 = program.position(5);
     const auto position_4 = program.position(4);
 
-    auto copy_5 = *position_5;
-    auto copy_4 = *position_4;
+    auto copy_5 = std::move(*position_5);
+    auto copy_4 = std::move(*position_4);
 
     program.erase(position_5, position_4 + 1);
     program.push_move(std::move(copy_5));
@@ -265,7 +267,7 @@ inline interpreter::result interpreter::op_if_dup(program& program)
 
 inline interpreter::result interpreter::op_depth(program& program)
 {
-    program.push_move(number(program.size()).data());
+    program.push(number(program.size()));
     return error::success;
 }
 
@@ -321,7 +323,7 @@ inline interpreter::result interpreter::op_roll(program& program)
     if (!program.pop_position(position))
         return error::op_roll;
 
-    auto copy = *position;
+    auto copy = std::move(*position);
     program.erase(position);
     program.push_move(std::move(copy));
     return error::success;
@@ -364,10 +366,8 @@ inline interpreter::result interpreter::op_size(program& program)
     if (program.empty())
         return error::op_size;
 
-    auto top = program.pop();
-    const auto size = top.size();
-    program.push_move(std::move(top));
-    program.push_move(number(size).data());
+    const auto size = program.item(0).size();
+    program.push(number(size));
     return error::success;
 }
 
@@ -396,7 +396,7 @@ inline interpreter::result interpreter::op_add1(program& program)
         return error::op_add1;
 
     number += 1;
-    program.push_move(number.data());
+    program.push(number);
     return error::success;
 }
 
@@ -407,7 +407,7 @@ inline interpreter::result interpreter::op_sub1(program& program)
         return error::op_sub1;
 
     number -= 1;
-    program.push_move(number.data());
+    program.push(number);
     return error::success;
 }
 
@@ -418,7 +418,7 @@ inline interpreter::result interpreter::op_negate(program& program)
         return error::op_negate;
 
     number = -number;
-    program.push_move(number.data());
+    program.push(number);
     return error::success;
 }
 
@@ -431,7 +431,7 @@ inline interpreter::result interpreter::op_abs(program& program)
     if (number < 0)
         number = -number;
 
-    program.push_move(number.data());
+    program.push(number);
     return error::success;
 }
 
@@ -462,7 +462,7 @@ inline interpreter::result interpreter::op_add(program& program)
         return error::op_add;
 
     const auto result = first + second;
-    program.push_move(result.data());
+    program.push(result);
     return error::success;
 }
 
@@ -473,7 +473,7 @@ inline interpreter::result interpreter::op_sub(program& program)
         return error::op_sub;
 
     const auto result = second - first;
-    program.push_move(result.data());
+    program.push(result);
     return error::success;
 }
 
@@ -574,7 +574,7 @@ inline interpreter::result interpreter::op_min(program& program)
     if (!program.pop_binary(first, second))
         return error::op_min;
 
-    program.push_move(second < first ? second.data() : first.data());
+    program.push(second < first ? second : first);
     return error::success;
 }
 
@@ -584,7 +584,7 @@ inline interpreter::result interpreter::op_max(program& program)
     if (!program.pop_binary(first, second))
         return error::op_max;
 
-    program.push_move(second > first ? second.data() : first.data());
+    program.push(second > first ? second : first);
     return error::success;
 }
 
@@ -603,7 +603,7 @@ inline interpreter::result interpreter::op_ripemd160(program& program)
     if (program.empty())
         return error::op_ripemd160;
 
-    program.push_move(ripemd160_hash_chunk(program.pop()));
+    program.push_move(ripemd160_hash(program.pop()));
     return error::success;
 }
 
@@ -612,7 +612,7 @@ inline interpreter::result interpreter::op_sha1(program& program)
     if (program.empty())
         return error::op_sha1;
 
-    program.push_move(sha1_hash_chunk(program.pop()));
+    program.push_move(sha1_hash(program.pop()));
     return error::success;
 }
 
@@ -621,7 +621,7 @@ inline interpreter::result interpreter::op_sha256(program& program)
     if (program.empty())
         return error::op_sha256;
 
-    program.push_move(sha256_hash_chunk(program.pop()));
+    program.push_move(sha256_hash(program.pop()));
     return error::success;
 }
 
@@ -630,7 +630,7 @@ inline interpreter::result interpreter::op_hash160(program& program)
     if (program.empty())
         return error::op_hash160;
 
-    program.push_move(ripemd160_hash_chunk(sha256_hash(program.pop())));
+    program.push_move(bitcoin_short_hash(program.pop()));
     return error::success;
 }
 
@@ -639,7 +639,7 @@ inline interpreter::result interpreter::op_hash256(program& program)
     if (program.empty())
         return error::op_hash256;
 
-    program.push_move(sha256_hash_chunk(sha256_hash(program.pop())));
+    program.push_move(bitcoin_hash(program.pop()));
     return error::success;
 }
 
@@ -655,26 +655,28 @@ inline interpreter::result interpreter::op_check_sig_verify(program& program)
     if (program.size() < 2)
         return error::op_check_sig_verify1;
 
-    uint8_t sighash;
     ec_signature signature;
-    der_signature distinguished;
     auto bip66 = chain::script::is_enabled(program.forks(), bip66_rule);
     auto bip143 = chain::script::is_enabled(program.forks(), bip143_rule);
 
     const auto public_key = program.pop();
-    auto endorsement = program.pop();
+    const auto endorsement = program.pop();
 
     // Create a subscript with endorsements stripped (sort of).
     chain::script script_code(program.subscript());
 
     // BIP143: find and delete of the signature is not applied for v0.
     if (!(bip143 && program.version() == script_version::zero))
-        script_code.find_and_delete({ endorsement });
+        script_code.find_and_delete({ endorsement.to_chunk() });
 
     // BIP62: An empty endorsement is not considered lax encoding.
-    if (!parse_endorsement(sighash, distinguished, std::move(endorsement)))
+    if (endorsement.empty())
         return error::invalid_signature_encoding;
 
+    // The endorsement is parsed in place (sighash type is the last byte).
+    const auto sighash = endorsement.back();
+    const data_slice distinguished(endorsement.begin(), endorsement.end() - 1);
+
     // Parse DER signature into an EC signature.
     if (!parse_signature(signature, distinguished, bip66))
         return bip66 ? error::invalid_signature_lax_encoding :
@@ -701,6 +703,28 @@ inline interpreter::result interpreter::op_check_sig(program& program)
     return error::success;
 }
 
+// private
+// Each sighash type is hashed at most once for a multisig evaluation.
+inline const hash_digest& interpreter::signature_hash(
+    signature_hashes& hashes, uint8_t sighash_type,
+    const chain::script& script_code, const program& program, bool bip143)
+{
+    for (const auto& hash: hashes)
+        if (hash.first == sighash_type)
+            return hash.second;
+
+    // Version condition preserves independence of bip141 and bip143.
+    const auto version = bip143 ? program.version() :
+        script_version::unversioned;
+
+    hashes.emplace_back(sighash_type,
+        chain::script::generate_signature_hash(program.transaction(),
+            program.input_index(), script_code, sighash_type, version,
+            program.value()));
+
+    return hashes.back().second;
+}
+
 inline interpreter::result interpreter::op_check_multisig_verify(
     program& program)
 {
@@ -712,7 +736,7 @@ inline interpreter::result interpreter::op_check_multisig_verify(
     if (!program.increment_operation_count(key_count))
         return error::op_check_multisig_verify2;
 
-    data_stack public_keys;
+    program::stack public_keys;
     if (!program.pop(public_keys, key_count))
         return error::op_check_multisig_verify3;
 
@@ -723,7 +747,7 @@ inline interpreter::result interpreter::op_check_multisig_verify(
     if (signature_count < 0 || signature_count > key_count)
         return error::op_check_multisig_verify5;
 
-    data_stack endorsements;
+    program::stack endorsements;
     if (!program.pop(endorsements, signature_count))
         return error::op_check_multisig_verify6;
 
@@ -737,9 +761,9 @@ inline interpreter::result interpreter::op_check_multisig_verify(
         rule_fork::bip147_rule))
         return error::op_check_multisig_verify8;
 
-    uint8_t sighash;
     ec_signature signature;
-    der_signature distinguished;
+    signature_hashes hashes;
+    hashes.reserve(endorsements.size());
     auto public_key = public_keys.begin();
     auto bip66 = chain::script::is_enabled(program.forks(), bip66_rule);
     auto bip143 = chain::script::is_enabled(program.forks(), bip143_rule);
@@ -749,31 +773,46 @@ inline interpreter::result interpreter::op_check_multisig_verify(
 
     // BIP143: find and delete of the signature is not applied for v0.
     if (!(bip143 && program.version() == script_version::zero))
-        script_code.find_and_delete(endorsements);
+    {
+        data_stack stripped;
+        stripped.reserve(endorsements.size());
+
+        for (const auto& endorsement: endorsements)
+            stripped.push_back(endorsement.to_chunk());
+
+        script_code.find_and_delete(stripped);
+    }
 
     // The exact number of signatures are required and must be in order.
     // One key can validate more than one script. So we always advance
     // until we exhaust either pubkeys (fail) or signatures (pass).
-    for (auto& endorsement: endorsements)
+    // Candidates are verified in order, not concurrently, as the walk attempts
+    // at most one key per step and callers verify inputs in parallel.
+    for (const auto& endorsement: endorsements)
     {
         // BIP62: An empty endorsement is not considered lax encoding.
-        if (!parse_endorsement(sighash, distinguished, std::move(endorsement)))
+        if (endorsement.empty())
             return error::invalid_signature_encoding;
 
+        // The endorsement is parsed in place (sighash type is the last byte).
+        const auto sighash = endorsement.back();
+        const data_slice distinguished(endorsement.begin(),
+            endorsement.end() - 1);
+
         // Parse DER signature into an EC signature.
         if (!parse_signature(signature, distinguished, bip66))
             return bip66 ? error::invalid_signature_lax_encoding :
                 error::invalid_signature_encoding;
 
-        // Version condition preserves independence of bip141 and bip143.
-        auto version = bip143 ? program.version() : script_version::unversioned;
+        // The signature hash is shared by all endorsements of its type.
+        const auto& hash = signature_hash(hashes, sighash, script_code,
+            program, bip143);
 
         while (true)
         {
-            // Version condition preserves independence of bip141 and bip143.
-            if (chain::script::check_signature(signature, sighash, *public_key,
-                script_code, program.transaction(), program.input_index(),
-                    version, program.value()))
+            // An empty public key is not a valid point (check_signature).
+            if (!public_key->empty() && verify_signature(
+                { public_key->begin(), public_key->end() }, hash, signature))
                 break;
 
             if (++public_key == public_keys.end())
@@ -888,6 +927,17 @@ inline interpreter::result interpreter::op_check_sequence_verify(
 }
 
 // It is expected that the compiler will produce a very efficient jump table.
+// The script position is known, so the jump register is set directly.
+inline interpreter::result interpreter::run_op(const program::op_iterator& op,
+    program& program)
+{
+    if (op->code() == opcode::codeseparator)
+        return program.set_jump_register(op, +1) ? error::success :
+            error::op_code_seperator;
+
+    return run_op(*op, program);
+}
+
 inline interpreter::result interpreter::run_op(const operation& op,
     program& program)
 {
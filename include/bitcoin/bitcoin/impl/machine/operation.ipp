@@ -206,13 +206,13 @@ inline opcode operation::opcode_from_size(size_t size)
         return opcode::push_four_size;
 }
 
-inline opcode operation::minimal_opcode_from_data(const data_chunk& data)
+inline opcode operation::minimal_opcode_from_data(data_slice data)
 {
     const auto size = data.size();
 
     if (size == 1)
     {
-        const auto value = data.front();
+        const auto value = *data.begin();
 
         if (value == number::negative_1)
             return opcode::push_negative_1;
@@ -22,12 +22,14 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 #include <bitcoin/bitcoin/chain/script.hpp>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/machine/number.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
 #include <bitcoin/bitcoin/machine/script_version.hpp>
+#include <bitcoin/bitcoin/machine/stack_element.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 
@@ -86,6 +88,11 @@ inline program::op_iterator program::end() const
     return script_.end();
 }
 
+inline const chain::script::branch::list& program::branches() const
+{
+    return script_.branches();
+}
+
 inline size_t program::operation_count() const
 {
     return operation_count_;
@@ -121,6 +128,15 @@ inline bool program::increment_operation_count(int32_t public_keys)
     return !operation_overflow(operation_count_);
 }
 
+// Counted operations of an unexecuted branch that is skipped as a whole.
+inline bool program::increment_operation_count(size_t skipped)
+{
+    // Addition is safe due to script size metadata.
+    operation_count_ += skipped;
+    return !operation_overflow(operation_count_);
+}
+
+// This is used to run individual operations, where the position is unknown.
 inline bool program::set_jump_register(const operation& op, int32_t offset)
 {
     if (script_.empty())
@@ -131,18 +147,25 @@ inline bool program::set_jump_register(const operation& op, int32_t offset)
         return &operation == &op;
     };
 
-    // This is not efficient but is simplifying and subscript is rarely used.
-    // Otherwise we must track the program counter through each evaluation.
-    jump_ = std::find_if(script_.begin(), script_.end(), finder);
+    const auto it = std::find_if(script_.begin(), script_.end(), finder);
 
-    if (jump_ == script_.end())
+    if (it == script_.end())
+        return false;
+
+    return set_jump_register(it, offset);
+}
+
+// Script evaluation tracks the position, so no search is required.
+inline bool program::set_jump_register(const op_iterator& op, int32_t offset)
+{
+    if (op == script_.end())
         return false;
 
     // This does not require guard because op_codeseparator can only increment.
     // Even if the opcode is last in the sequnce the increment is valid (end).
     BITCOIN_ASSERT_MSG(offset == 1, "unguarded jump offset");
 
-    jump_ += offset;
+    jump_ = op + offset;
     return true;
 }
 
@@ -155,6 +178,14 @@ inline void program::push(bool value)
     push_move(value ? value_type{ number::positive_1 } : value_type{});
 }
 
+// The number is encoded directly into the (inline) stack item.
+inline void program::push(const number& value)
+{
+    number::encoding data;
+    const auto size = value.data(data);
+    primary_.emplace_back(data.data(), data.data() + size);
+}
+
 // Be explicit about the intent to move or copy, to get compiler help.
 inline void program::push_move(value_type&& item)
 {
@@ -171,10 +202,10 @@ inline void program::push_copy(const value_type& item)
 //-----------------------------------------------------------------------------
 
 // This must be guarded.
-inline data_chunk program::pop()
+inline program::value_type program::pop()
 {
     BITCOIN_ASSERT(!empty());
-    const auto value = primary_.back();
+    auto value = std::move(primary_.back());
     primary_.pop_back();
     return value;
 }
@@ -191,7 +222,12 @@ inline bool program::pop(int32_t& out_value)
 
 inline bool program::pop(number& out_number, size_t maxiumum_size)
 {
-    return !empty() && out_number.set_data(pop(), maxiumum_size);
+    if (empty() || !out_number.set_data(item(0), maxiumum_size))
+        return false;
+
+    // The number is decoded in place, there is no need to move it out.
+    primary_.pop_back();
+    return true;
 }
 
 inline bool program::pop_binary(number& first, number& second)
@@ -228,11 +264,13 @@ inline bool program::pop_position(stack_iterator& out_position)
 }
 
 // pop1/pop2/.../pop[count]
-inline bool program::pop(data_stack& section, size_t count)
+inline bool program::pop(stack& section, size_t count)
 {
     if (size() < count)
         return false;
 
+    section.reserve(count);
+
     for (size_t i = 0; i < count; ++i)
         section.push_back(pop());
 
@@ -253,8 +291,8 @@ inline void program::swap(size_t index_left, size_t index_right)
 {
     // TODO: refactor to allow DRY without const_cast here.
     std::swap(
-        const_cast<data_stack::value_type&>(item(index_left)),
-        const_cast<data_stack::value_type&>(item(index_right)));
+        const_cast<value_type&>(item(index_left)),
+        const_cast<value_type&>(item(index_right)));
 }
 
 // pop1/pop2/.../pop[pos-1]/pop[pos]/push[pos-1]/.../push2/push1
@@ -320,7 +358,7 @@ inline bool program::if_(const operation& op) const
     return op.is_conditional() || succeeded();
 }
 
-inline const data_stack::value_type& program::item(size_t index) /*const*/
+inline const program::value_type& program::item(size_t index) /*const*/
 {
     return *position(index);
 }
@@ -370,7 +408,7 @@ inline void program::push_alternate(value_type&& value)
 inline program::value_type program::pop_alternate()
 {
     BITCOIN_ASSERT(!alternate_.empty());
-    const auto value = alternate_.back();
+    auto value = std::move(alternate_.back());
     alternate_.pop_back();
     return value;
 }
@@ -0,0 +1,218 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MACHINE_STACK_ELEMENT_IPP
+#define LIBBITCOIN_MACHINE_STACK_ELEMENT_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace machine {
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+inline stack_element::stack_element()
+  : size_(0)
+{
+}
+
+inline stack_element::stack_element(stack_element&& other)
+  : size_(0)
+{
+    *this = std::move(other);
+}
+
+inline stack_element::stack_element(const stack_element& other)
+  : size_(0)
+{
+    assign(other.data(), other.size());
+}
+
+inline stack_element::stack_element(data_chunk&& data)
+  : size_(0)
+{
+    assign(std::move(data));
+}
+
+inline stack_element::stack_element(const data_chunk& data)
+  : size_(0)
+{
+    assign(data.data(), data.size());
+}
+
+template <size_t Size>
+stack_element::stack_element(const byte_array<Size>& data)
+  : size_(0)
+{
+    assign(data.data(), Size);
+}
+
+inline stack_element::stack_element(const uint8_t* begin, const uint8_t* end)
+  : size_(0)
+{
+    BITCOIN_ASSERT(begin <= end);
+    assign(begin, static_cast<size_t>(end - begin));
+}
+
+inline stack_element::stack_element(uint8_t value)
+  : size_(1)
+{
+    inline_[0] = value;
+}
+
+// Operators.
+//-----------------------------------------------------------------------------
+
+inline stack_element& stack_element::operator=(stack_element&& other)
+{
+    if (this == &other)
+        return *this;
+
+    if (other.is_inline())
+    {
+        assign(other.inline_, other.size_);
+    }
+    else
+    {
+        heap_ = std::move(other.heap_);
+        size_ = other.size_;
+    }
+
+    other.size_ = 0;
+    return *this;
+}
+
+inline stack_element& stack_element::operator=(const stack_element& other)
+{
+    if (this != &other)
+        assign(other.data(), other.size());
+
+    return *this;
+}
+
+inline bool stack_element::operator==(const stack_element& other) const
+{
+    return size_ == other.size_ &&
+        (size_ == 0 || std::memcmp(data(), other.data(), size_) == 0);
+}
+
+inline bool stack_element::operator!=(const stack_element& other) const
+{
+    return !(*this == other);
+}
+
+inline uint8_t stack_element::operator[](size_t index) const
+{
+    BITCOIN_ASSERT(index < size_);
+    return data()[index];
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+inline bool stack_element::empty() const
+{
+    return size_ == 0;
+}
+
+inline size_t stack_element::size() const
+{
+    return size_;
+}
+
+inline const uint8_t* stack_element::data() const
+{
+    return is_inline() ? inline_ : heap_.data();
+}
+
+inline stack_element::const_iterator stack_element::begin() const
+{
+    return data();
+}
+
+inline stack_element::const_iterator stack_element::end() const
+{
+    return data() + size_;
+}
+
+inline uint8_t stack_element::front() const
+{
+    BITCOIN_ASSERT(!empty());
+    return data()[0];
+}
+
+inline uint8_t stack_element::back() const
+{
+    BITCOIN_ASSERT(!empty());
+    return data()[size_ - 1];
+}
+
+inline data_chunk stack_element::to_chunk() const
+{
+    return data_chunk(begin(), end());
+}
+
+// private
+inline bool stack_element::is_inline() const
+{
+    return size_ <= capacity;
+}
+
+// private
+inline void stack_element::assign(const uint8_t* begin, size_t size)
+{
+    if (size <= capacity)
+    {
+        // The source may not overlap as it is never this inline buffer.
+        if (size != 0)
+            std::memcpy(inline_, begin, size);
+
+        heap_.clear();
+    }
+    else
+    {
+        heap_.assign(begin, begin + size);
+    }
+
+    size_ = size;
+}
+
+// private
+inline void stack_element::assign(data_chunk&& data)
+{
+    if (data.size() <= capacity)
+    {
+        assign(data.data(), data.size());
+        return;
+    }
+
+    heap_ = std::move(data);
+    size_ = heap_.size();
+}
+
+} // namespace machine
+} // namespace libbitcoin
+
+#endif
@@ -264,6 +264,22 @@ data_chunk deserializer<Iterator, CheckSafe>::read_bytes(size_t size)
     return out;
 }
 
+// The buffer is left unchanged if the read is not safe.
+template <typename Iterator, bool CheckSafe>
+void deserializer<Iterator, CheckSafe>::read_bytes(uint8_t* buffer,
+    size_t size)
+{
+    if (!safe(size))
+        invalidate();
+
+    if (!valid_ || size == 0)
+        return;
+
+    const auto begin = iterator_;
+    iterator_ += size;
+    std::copy_n(begin, size, buffer);
+}
+
 template <typename Iterator, bool CheckSafe>
 std::string deserializer<Iterator, CheckSafe>::read_string()
 {
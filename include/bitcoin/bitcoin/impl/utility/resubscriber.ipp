@@ -66,16 +66,13 @@ void resubscriber<Args...>::start()
 {
     // Critical Section
     ///////////////////////////////////////////////////////////////////////////
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::start() calling lock_upgrade() for subscribe_mutex_ of "
     << &subscribe_mutex_;
 
     subscribe_mutex_.lock_upgrade();
 
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::start() called lock_upgrade() successfully for subscribe_mutex_ of "
     << &subscribe_mutex_;
 
@@ -89,15 +86,13 @@ void resubscriber<Args...>::start()
         return;
     }
 
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::start() calling unlock_upgrade() for subscribe_mutex_ of "
     << &subscribe_mutex_;
 
     subscribe_mutex_.unlock_upgrade();
 
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::start() called unlock_upgrade() successfully for subscribe_mutex_ of "
     << &subscribe_mutex_;
     ///////////////////////////////////////////////////////////////////////////
@@ -108,16 +103,13 @@ void resubscriber<Args...>::stop()
 {
     // Critical Section
     ///////////////////////////////////////////////////////////////////////////
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::stop() calling lock_upgrade() for subscribe_mutex_ of "
     << &subscribe_mutex_;
 
     subscribe_mutex_.lock_upgrade();
 
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::stop() called lock_upgrade() successfully for subscribe_mutex_ of "
     << &subscribe_mutex_;
 
@@ -131,15 +123,13 @@ void resubscriber<Args...>::stop()
         return;
     }
 
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::stop() calling unlock_upgrade() for subscribe_mutex_ of "
     << &subscribe_mutex_;
 
     subscribe_mutex_.unlock_upgrade();
 
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::stop() called unlock_upgrade() successfully for subscribe_mutex_ of "
     << &subscribe_mutex_;
     ///////////////////////////////////////////////////////////////////////////
@@ -150,16 +140,13 @@ void resubscriber<Args...>::subscribe(handler&& notify, Args... stopped_args)
 {
     // Critical Section
     ///////////////////////////////////////////////////////////////////////////
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::subscribe() calling lock_upgrade() for subscribe_mutex_ of "
     << &subscribe_mutex_;
 
     subscribe_mutex_.lock_upgrade();
 
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::subscribe() called lock_upgrade() successfully for subscribe_mutex_ of "
     << &subscribe_mutex_;
 
@@ -173,15 +160,13 @@ void resubscriber<Args...>::subscribe(handler&& notify, Args... stopped_args)
         return;
     }
 
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::subscribe() calling unlock_upgrade() for subscribe_mutex_ of "
     << &subscribe_mutex_;
 
     subscribe_mutex_.unlock_upgrade();
 
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::subscribe() called unlock_upgrade() successfully for subscribe_mutex_ of "
     << &subscribe_mutex_;
     ///////////////////////////////////////////////////////////////////////////
@@ -209,30 +194,25 @@ void resubscriber<Args...>::do_invoke(Args... args)
 {
     // Critical Section (prevent concurrent handler execution)
     ///////////////////////////////////////////////////////////////////////////
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::do_invoke() instantiating unique_lock() for invoke_mutex_ of "
     << &invoke_mutex_;
 
     unique_lock lock(invoke_mutex_);
 
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::do_invoke() created unique_lock() successfully for invoke_mutex_ of "
     << &invoke_mutex_;
 
     // Critical Section (protect stop)
     ///////////////////////////////////////////////////////////////////////////
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::do_invoke() calling lock() for subscribe_mutex_ of "
     << &subscribe_mutex_;
 
     subscribe_mutex_.lock();
 
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " resubscriber::do_invoke() called lock() successfully for subscribe_mutex_ of "
     << &subscribe_mutex_;
 
@@ -252,8 +232,7 @@ void resubscriber<Args...>::do_invoke(Args... args)
         //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
         std::tuple<Args...> tuple_{args...};
 
-        LOG_VERBOSE(LOG_SYSTEM)
-        << this_id
+        LOG_TRACE(LOG_SYSTEM)
         << " resubscriber::do_invoke() calling handler(args...) for handler @ "
         << &handler;
 
@@ -274,8 +253,7 @@ void resubscriber<Args...>::do_invoke(Args... args)
             //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
             subscriptions_.push_back(handler);
 
-            LOG_VERBOSE(LOG_SYSTEM)
-            << this_id
+            LOG_TRACE(LOG_SYSTEM)
             << " resubscriber::do_invoke() called push_back() for handler @ "
             << &handler;
 
@@ -212,8 +212,8 @@ void serializer<Iterator>::write_string(const std::string& value, size_t size)
 {
     const auto length = std::min(size, value.size());
     write_bytes(reinterpret_cast<const uint8_t*>(value.data()), length);
-    data_chunk padding(floor_subtract(size, length), string_terminator);
-    write_bytes(padding);
+    iterator_ = std::fill_n(iterator_, floor_subtract(size, length),
+        string_terminator);
 }
 
 template <typename Iterator>
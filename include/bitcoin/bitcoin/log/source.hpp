@@ -23,6 +23,7 @@
 #include <boost/log/attributes/clock.hpp>
 #include <boost/log/sources/global_logger_storage.hpp>
 #include <boost/log/sources/severity_channel_logger.hpp>
+#include <boost/thread/thread.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/log/attributes.hpp>
 #include <bitcoin/bitcoin/log/severity.hpp>
@@ -51,6 +52,17 @@ BOOST_LOG_INLINE_GLOBAL_LOGGER_INIT(source, severity_source)
 #define LOG_ERROR(module) BC_LOG_SEVERITY(module, error)
 #define LOG_FATAL(module) BC_LOG_SEVERITY(module, fatal)
 
+// Hot path tracing is compiled out unless BC_LOG_TRACE is defined (see
+// --enable-trace). When compiled in it is verbose, prefixed by the thread id,
+// and the id and message are not evaluated unless the record is accepted.
+#ifdef BC_LOG_TRACE
+    #define LOG_TRACE(module) \
+        LOG_VERBOSE(module) << boost::this_thread::get_id()
+#else
+    #define LOG_TRACE(module) \
+        if (true) {} else LOG_VERBOSE(module)
+#endif
+
 } // namespace log
 } // namespace libbitcoin
 
@@ -20,11 +20,15 @@
 #define LIBBITCOIN_MACHINE_INTERPRETER_HPP
 
 #include <cstdint>
+#include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/chain/script.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
 #include <bitcoin/bitcoin/machine/program.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 
 namespace libbitcoin {
@@ -118,7 +122,14 @@ public:
     static code run(const operation& op, program& program);
 
 private:
+    typedef std::vector<std::pair<uint8_t, hash_digest>> signature_hashes;
+
+    static const hash_digest& signature_hash(signature_hashes& hashes,
+        uint8_t sighash_type, const chain::script& script_code,
+        const program& program, bool bip143);
+
     static result run_op(const operation& op, program& program);
+    static result run_op(const program::op_iterator& op, program& program);
 };
 
 } // namespace machine
@@ -61,6 +61,10 @@ public:
     static const uint8_t positive_16;
     static const uint8_t negative_mask;
 
+    /// The encoding capacity, sufficient for any int64 value.
+    static BC_CONSTEXPR size_t max_data_size = sizeof(int64_t) + 1;
+    typedef byte_array<max_data_size> encoding;
+
     /// Construct with zero value.
     number();
 
@@ -68,7 +72,7 @@ public:
     explicit number(int64_t value);
 
     /// Replace the value derived from a byte vector with LSB first ordering.
-    bool set_data(const data_chunk& data, size_t max_size);
+    bool set_data(data_slice data, size_t max_size);
 
     // Properties
     //-------------------------------------------------------------------------
@@ -76,6 +80,9 @@ public:
     /// Return the value as a byte vector with LSB first ordering.
     data_chunk data() const;
 
+    /// Write the value with LSB first ordering, returns the encoded size.
+    size_t data(encoding& out) const;
+
     /// Return the value bounded by the limits of int32.
     int32_t int32() const;
 
@@ -104,7 +104,7 @@ public:
 
     /// Compute the minimal data opcode for a given chunk of data.
     /// Caller should clear data if converting to non-payload opcode.
-    static opcode minimal_opcode_from_data(const data_chunk& data);
+    static opcode minimal_opcode_from_data(data_slice data);
 
     /// Compute the nominal data opcode for a given chunk of data.
     /// Restricted to sized data, avoids conversion to numeric opcodes.
@@ -28,6 +28,7 @@
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
 #include <bitcoin/bitcoin/machine/script_version.hpp>
+#include <bitcoin/bitcoin/machine/stack_element.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 
 namespace libbitcoin {
@@ -36,14 +37,15 @@ namespace machine {
 class BC_API program
 {
 public:
-    typedef data_stack::value_type value_type;
+    typedef stack_element value_type;
+    typedef stack_element::list stack;
     typedef operation::iterator op_iterator;
 
     // Older libstdc++ does not allow erase with const iterator.
     // This is a bug that requires we up the minimum compiler version.
     // So presently stack_iterator is a non-const iterator.
-    ////typedef data_stack::const_iterator stack_iterator;
-    typedef data_stack::iterator stack_iterator;
+    ////typedef stack::const_iterator stack_iterator;
+    typedef stack::iterator stack_iterator;
 
     /// Create an instance that does not expect to verify signatures.
     /// This is useful for script utilities but not with input metadata.
@@ -61,7 +63,7 @@ public:
 
     /// Create an instance with initialized stack (witness run, v0 by default).
     program(const chain::script& script, const chain::transaction& transaction,
-        uint32_t input_index, uint32_t forks, data_stack&& stack,
+        uint32_t input_index, uint32_t forks, stack&& stack,
         uint64_t value, script_version version=script_version::zero);
 
     /// Create using copied tx, input, forks, value, stack (prevout run).
@@ -82,6 +84,7 @@ public:
     op_iterator begin() const;
     op_iterator jump() const;
     op_iterator end() const;
+    const chain::script::branch::list& branches() const;
     size_t operation_count() const;
 
     /// Instructions.
@@ -89,24 +92,27 @@ public:
     code evaluate(const operation& op);
     bool increment_operation_count(const operation& op);
     bool increment_operation_count(int32_t public_keys);
+    bool increment_operation_count(size_t skipped);
     bool set_jump_register(const operation& op, int32_t offset);
+    bool set_jump_register(const op_iterator& op, int32_t offset);
 
     // Primary stack.
     //-------------------------------------------------------------------------
 
     /// Primary push.
     void push(bool value);
+    void push(const number& value);
     void push_move(value_type&& item);
     void push_copy(const value_type& item);
 
-    /// Primary pop.
-    data_chunk pop();
+    /// Primary pop (the item is moved out of the stack).
+    value_type pop();
     bool pop(int32_t& out_value);
     bool pop(number& out_number, size_t maxiumum_size=max_number_size);
     bool pop_binary(number& first, number& second);
     bool pop_ternary(number& first, number& second, number& third);
     bool pop_position(stack_iterator& out_position);
-    bool pop(data_stack& section, size_t count);
+    bool pop(stack& section, size_t count);
 
     /// Primary push/pop optimizations (active).
     void duplicate(size_t index);
@@ -159,8 +165,8 @@ private:
     size_t negative_count_;
     size_t operation_count_;
     op_iterator jump_;
-    data_stack primary_;
-    data_stack alternate_;
+    stack primary_;
+    stack alternate_;
     bool_stack condition_;
 };
 
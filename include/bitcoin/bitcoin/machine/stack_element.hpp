@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MACHINE_STACK_ELEMENT_HPP
+#define LIBBITCOIN_MACHINE_STACK_ELEMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace machine {
+
+/// A script stack item. Items up to the inline capacity (which covers
+/// endorsements, public keys, hashes and numbers) are stored in place, so
+/// pushing them does not allocate. Larger items are stored on the heap.
+class BC_API stack_element
+{
+public:
+    typedef std::vector<stack_element> list;
+    typedef uint8_t value_type;
+    typedef const uint8_t* const_iterator;
+
+    /// Holds a max size endorsement (73) or an uncompressed public key (65).
+    static BC_CONSTEXPR size_t capacity = 80;
+
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    stack_element();
+
+    stack_element(stack_element&& other);
+    stack_element(const stack_element& other);
+
+    /// A moved chunk that exceeds the inline capacity is not copied.
+    stack_element(data_chunk&& data);
+    stack_element(const data_chunk& data);
+
+    template <size_t Size>
+    stack_element(const byte_array<Size>& data);
+
+    stack_element(const uint8_t* begin, const uint8_t* end);
+
+    /// A single byte item, such as a small number.
+    explicit stack_element(uint8_t value);
+
+    // Operators.
+    //-------------------------------------------------------------------------
+
+    /// This class is move assignable and copy assignable.
+    stack_element& operator=(stack_element&& other);
+    stack_element& operator=(const stack_element& other);
+
+    bool operator==(const stack_element& other) const;
+    bool operator!=(const stack_element& other) const;
+
+    uint8_t operator[](size_t index) const;
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    bool empty() const;
+    size_t size() const;
+    const uint8_t* data() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+    uint8_t front() const;
+    uint8_t back() const;
+
+    /// Copy the item to a new chunk.
+    data_chunk to_chunk() const;
+
+private:
+    bool is_inline() const;
+    void assign(const uint8_t* begin, size_t size);
+    void assign(data_chunk&& data);
+
+    size_t size_;
+    data_chunk heap_;
+    uint8_t inline_[capacity];
+};
+
+} // namespace machine
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/machine/stack_element.ipp>
+
+#endif
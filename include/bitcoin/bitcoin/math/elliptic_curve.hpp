@@ -164,8 +164,8 @@ BC_API bool parse_endorsement(uint8_t& sighash_type,
 
 /// Parse a DER encoded signature with optional strict DER enforcement.
 /// Treat an empty DER signature as invalid, in accordance with BIP66.
-BC_API bool parse_signature(ec_signature& out,
-    const der_signature& der_signature, bool strict);
+BC_API bool parse_signature(ec_signature& out, data_slice der_signature,
+    bool strict);
 
 /// Encode an EC signature as DER (strict).
 BC_API bool encode_signature(der_signature& out, const ec_signature& signature);
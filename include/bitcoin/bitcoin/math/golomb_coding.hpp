@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_GOLOMB_CODING_HPP
+#define LIBBITCOIN_GOLOMB_CODING_HPP
+
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/// Golomb-Rice coded sets (BIP158). Items are siphashed into the range
+/// [0, count * rate), sorted and the deltas coded with the given number of
+/// remainder bits. The item count is not encoded in the set.
+
+/// Construct the coded set of the items (which should be distinct).
+BC_API data_chunk golomb_construct(const std::vector<data_slice>& items,
+    uint8_t bits, const siphash_key& key, uint64_t rate);
+
+/// The target is (probably) in the coded set of count items.
+BC_API bool golomb_match(data_slice target, data_slice set, uint64_t count,
+    uint8_t bits, const siphash_key& key, uint64_t rate);
+
+/// Any of the targets is (probably) in the coded set of count items. The
+/// set is decoded once, merged against the sorted hashes of the targets.
+BC_API bool golomb_match(const std::vector<data_slice>& targets,
+    data_slice set, uint64_t count, uint8_t bits, const siphash_key& key,
+    uint64_t rate);
+
+} // namespace libbitcoin
+
+#endif
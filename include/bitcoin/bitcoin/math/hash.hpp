@@ -124,6 +124,9 @@ BC_API data_chunk scrypt(data_slice data, data_slice salt, uint64_t N,
 /// Generate a bitcoin hash.
 BC_API hash_digest bitcoin_hash(data_slice data);
 
+/// Generate a bitcoin hash of the concatenated slices (without copying).
+BC_API hash_digest bitcoin_hash(loaf slices);
+
 /// Generate a scrypt hash.
 BC_API hash_digest scrypt_hash(data_slice data);
 
@@ -0,0 +1,44 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SIPHASH_HPP
+#define LIBBITCOIN_SIPHASH_HPP
+
+#include <cstdint>
+#include <tuple>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+
+/// The two 64 bit little-endian halves of a 128 bit siphash key.
+typedef std::tuple<uint64_t, uint64_t> siphash_key;
+
+/// Generate a siphash-2-4 of the message.
+BC_API uint64_t siphash(const siphash_key& key, data_slice message);
+
+/// Generate a siphash-2-4 of the message, keyed by the given hash.
+BC_API uint64_t siphash(const half_hash& hash, data_slice message);
+
+/// Split a 128 bit hash into a siphash key.
+BC_API siphash_key to_siphash_key(const half_hash& hash);
+
+} // namespace libbitcoin
+
+#endif
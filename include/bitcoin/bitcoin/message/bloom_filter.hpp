@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_BLOOM_FILTER_HPP
+#define LIBBITCOIN_MESSAGE_BLOOM_FILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/message/filter_load.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// A BIP37 connection filter, loaded by filterload and extended by filteradd.
+/// This is not a message, it evaluates transactions against peer filters.
+class BC_API bloom_filter
+{
+public:
+    /// BIP37 filterload flags, governing update of the filter on match.
+    enum update : uint8_t
+    {
+        update_none = 0,
+        update_all = 1,
+        update_p2pubkey_only = 2,
+        update_mask = 3
+    };
+
+    bloom_filter();
+    bloom_filter(const filter_load& load);
+    bloom_filter(data_chunk&& filter, uint32_t hash_functions,
+        uint32_t tweak, uint8_t flags);
+
+    /// The filter is within BIP37 size and hash function limits.
+    bool is_valid() const;
+
+    /// Add an element to the filter (filteradd).
+    void insert(data_slice element);
+
+    /// The element is (probably) in the filter.
+    bool contains(data_slice element) const;
+
+    /// The transaction id, an output script push, a spent outpoint or an input
+    /// script push is in the filter. Outpoints of matching outputs are added
+    /// to the filter as directed by the update flags.
+    bool matches(const chain::transaction& tx);
+
+    const data_chunk& filter() const;
+    uint32_t hash_functions() const;
+    uint32_t tweak() const;
+    uint8_t flags() const;
+
+private:
+    size_t bit_index(uint32_t function, data_slice element) const;
+    bool matches(const chain::script& script) const;
+    void update_empty_full();
+
+    data_chunk filter_;
+    uint32_t hash_functions_;
+    uint32_t tweak_;
+    uint8_t flags_;
+
+    // Short circuit membership of all clear (or empty) and all set filters.
+    bool empty_;
+    bool full_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
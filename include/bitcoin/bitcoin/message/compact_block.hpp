@@ -21,7 +21,13 @@
 
 #include <istream>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/message/block_transactions.hpp>
+#include <bitcoin/bitcoin/message/get_block_transactions.hpp>
 #include <bitcoin/bitcoin/message/prefilled_transaction.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
@@ -43,19 +49,29 @@ public:
     static compact_block factory(uint32_t version, std::istream& stream);
     static compact_block factory(uint32_t version, reader& source);
 
+    /// Build a compact block announcing the block, with the coinbase
+    /// prefilled and all other transactions identified by short id. Short
+    /// ids are derived from witness hashes if witness is set (version 2).
+    static compact_block factory(const chain::block& block, uint64_t nonce,
+        bool witness=false);
+
+    /// The short id of a transaction hash under the given siphash key.
+    static short_id to_short_id(const siphash_key& key,
+        const hash_digest& hash);
+
     compact_block();
-    compact_block( chain::header& header, uint64_t nonce,
+    compact_block(const chain::header& header, uint64_t nonce,
         const short_id_list& short_ids,
         const prefilled_transaction::list& transactions);
     compact_block(chain::header&& header, uint64_t nonce,
         short_id_list&& short_ids,
         prefilled_transaction::list&& transactions);
-    compact_block( compact_block& other);
+    compact_block(const compact_block& other);
     compact_block(compact_block&& other);
 
     chain::header& header();
     const chain::header& header() const;
-    void set_header( chain::header& value);
+    void set_header(const chain::header& value);
     void set_header(chain::header&& value);
 
     uint64_t nonce() const;
@@ -71,6 +87,25 @@ public:
     void set_transactions(const prefilled_transaction::list& value);
     void set_transactions(prefilled_transaction::list&& value);
 
+    /// The siphash key of the short ids, derived from header and nonce.
+    siphash_key short_id_key() const;
+
+    /// Reconstruct the block from the prefilled transactions and the known
+    /// transactions whose short ids match. Unmatched transactions are left
+    /// default and their (differentially encoded) indexes are set on the
+    /// missing request, which is empty if the block is complete. Returns false
+    /// if the compact block is malformed, its short ids collide or a complete
+    /// block does not match the header merkle root (fetch the full block).
+    bool reconstruct(chain::block& out, get_block_transactions& missing,
+        const chain::transaction::list& known, bool witness=false) const;
+
+    /// Complete a reconstruction with the response to its missing request.
+    /// Returns false if the response does not correspond to the request or
+    /// the completed block does not match the header merkle root.
+    static bool reconstruct(chain::block& out,
+        const get_block_transactions& missing,
+        const block_transactions& response);
+
     bool from_data(uint32_t version, const data_chunk& data);
     bool from_data(uint32_t version, std::istream& stream);
     bool from_data(uint32_t version, reader& source);
@@ -83,7 +118,7 @@ public:
 
     // This class is move assignable but not copy assignable.
     compact_block& operator=(compact_block&& other);
-    void operator=( compact_block&) = delete;
+    void operator=(const compact_block&) = delete;
 
     bool operator==(const compact_block& other) const;
     bool operator!=(const compact_block& other) const;
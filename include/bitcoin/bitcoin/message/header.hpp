@@ -56,9 +56,9 @@ public:
     header(uint32_t version, hash_digest&& previous_block_hash,
         hash_digest&& merkle, uint32_t timestamp, uint32_t bits,
         uint32_t nonce);
-    header( chain::header& other);
+    header(const chain::header& other);
     header(chain::header&& other);
-    header( header& other);
+    header(const header& other);
     header(header&& other);
 
     bool from_data(uint32_t version, const data_chunk& data);
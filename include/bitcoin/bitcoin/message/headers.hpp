@@ -19,21 +19,28 @@
 #ifndef LIBBITCOIN_MESSAGE_HEADERS_HPP
 #define LIBBITCOIN_MESSAGE_HEADERS_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <istream>
 #include <memory>
 #include <string>
+#include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/message/header.hpp>
 #include <bitcoin/bitcoin/message/inventory.hpp>
 #include <bitcoin/bitcoin/message/inventory_vector.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
 namespace libbitcoin {
+
+class settings;
+
 namespace message {
 
 class BC_API headers
@@ -47,14 +54,14 @@ public:
     static headers factory(uint32_t version, reader& source);
 
     headers();
-    headers( header::list& values);
+    headers(const header::list& values);
     headers(header::list&& values);
-//    headers(const std::initializer_list<header>& values);
-    headers( headers& other);
+    headers(const std::initializer_list<header>& values);
+    headers(const headers& other);
     headers(headers&& other);
 
     header::list& elements();
-//    const header::list& elements() const;
+    const header::list& elements() const;
     void set_elements(const header::list& values);
     void set_elements(header::list&& values);
 
@@ -63,6 +70,15 @@ public:
     void to_inventory(inventory_vector::list& out,
         inventory::type_id type) const;
 
+    /// Validate the headers in order as successors of the parent (block or
+    /// header) state. Hashing, proof of work and timestamp checks run on the
+    /// pool, then linkage is verified against the cached hashes and the chain
+    /// state is folded forward for acceptance, populating metadata.state of
+    /// each header. Index is set to the position of the first invalid header,
+    /// or to the number of headers if all are valid.
+    code validate(const chain::chain_state& parent, threadpool& pool,
+        settings& settings, size_t& index, bool scrypt=false);
+
     bool from_data(uint32_t version, const data_chunk& data);
     bool from_data(uint32_t version, std::istream& stream);
     bool from_data(uint32_t version, reader& source);
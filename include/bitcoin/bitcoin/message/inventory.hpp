@@ -28,6 +28,7 @@
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/message/inventory_vector.hpp>
+#include <bitcoin/bitcoin/message/rolling_filter.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
@@ -67,6 +68,9 @@ public:
     void to_data(uint32_t version, writer& sink) const;
     void to_hashes(hash_list& out, type_id type) const;
     void reduce(inventory_vector::list& out, type_id type) const;
+
+    /// Remove the inventories that are (probably) known, in place.
+    void filter_unknown(const rolling_filter& known);
     bool is_valid() const;
     void reset();
     size_t serialized_size(uint32_t version) const;
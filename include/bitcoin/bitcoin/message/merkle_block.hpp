@@ -22,9 +22,12 @@
 #include <istream>
 #include <memory>
 #include <string>
+#include <vector>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/bloom_filter.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
@@ -38,23 +41,33 @@ public:
     typedef std::vector<merkle_block> list;
     typedef std::shared_ptr<merkle_block> ptr;
     typedef std::shared_ptr<merkle_block> const_ptr;
+    typedef std::vector<size_t> indexes;
 
     static merkle_block factory(uint32_t version, const data_chunk& data);
     static merkle_block factory(uint32_t version, std::istream& stream);
     static merkle_block factory(uint32_t version, reader& source);
 
     merkle_block();
-    merkle_block( chain::header& header, size_t total_transactions,
+    merkle_block(const chain::header& header, size_t total_transactions,
         const hash_list& hashes, const data_chunk& flags);
     merkle_block(chain::header&& header, size_t total_transactions,
         hash_list&& hashes, data_chunk&& flags);
-    merkle_block( chain::block& block);
-    merkle_block( merkle_block& other);
+    merkle_block(const chain::block& block);
+
+    /// Construct a partial merkle tree proving the block transactions at the
+    /// positions flagged in matches.
+    merkle_block(const chain::block& block,
+        const std::vector<bool>& matches);
+
+    /// Construct a partial merkle tree proving the block transactions that
+    /// match the filter, updating the filter as directed by its flags.
+    merkle_block(const chain::block& block, bloom_filter& filter);
+    merkle_block(const merkle_block& other);
     merkle_block(merkle_block&& other);
 
     chain::header& header();
     const chain::header& header() const;
-    void set_header( chain::header& value);
+    void set_header(const chain::header& value);
     void set_header(chain::header&& value);
 
     size_t total_transactions() const;
@@ -70,6 +83,11 @@ public:
     void set_flags(const data_chunk& value);
     void set_flags(data_chunk&& value);
 
+    /// Traverse the partial merkle tree, validating it and its root against
+    /// the header in a single pass. Returns false if invalid, otherwise sets
+    /// the proven transaction hashes and their positions within the block.
+    bool extract_matches(hash_list& out_hashes, indexes& out_indexes) const;
+
     bool from_data(uint32_t version, const data_chunk& data);
     bool from_data(uint32_t version, std::istream& stream);
     bool from_data(uint32_t version, reader& source);
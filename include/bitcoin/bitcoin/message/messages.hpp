@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstddef>
+#include <string>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/address.hpp>
 #include <bitcoin/bitcoin/message/alert.hpp>
@@ -54,8 +55,12 @@
 #include <bitcoin/bitcoin/message/transaction.hpp>
 #include <bitcoin/bitcoin/message/verack.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
-#include <bitcoin/bitcoin/utility/container_sink.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/buffer_pool.hpp>
+#include <bitcoin/bitcoin/utility/checksum_writer.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
+#include <bitcoin/bitcoin/utility/writer.hpp>
 
 // Minimum current libbitcoin protocol version:     31402
 // Minimum current satoshi client protocol version: 31800
@@ -148,43 +153,71 @@ DECLARE_MESSAGE_POINTER_LIST_POINTER_TYPES(transaction);
 
 namespace message {
 
+/// Append the framed message to the empty buffer, false if the payload write
+/// fails or does not match the given payload size.
+template <typename Payload>
+bool write_message(data_chunk& data, const std::string& command,
+    uint32_t magic, size_t payload_size, Payload write_payload)
+{
+    BITCOIN_ASSERT(data.empty());
+    const auto heading_size = heading::satoshi_fixed_size();
+    data.reserve(heading_size + payload_size);
+
+    // The heading is written in place once the payload checksum is known.
+    data.resize(heading_size);
+
+    // Append the payload, computing its checksum in the same pass so that the
+    // payload is neither zero filled nor read back for hashing.
+    checksum_writer sink(data, payload_size);
+    write_payload(sink);
+
+    if (!sink || sink.size() != payload_size)
+        return false;
+
+    const auto payload_size32 = safe_unsigned<uint32_t>(payload_size);
+    auto head = make_unsafe_serializer(data.begin());
+    head.write_4_bytes_little_endian(magic);
+    head.write_string(command, command_size);
+    head.write_4_bytes_little_endian(payload_size32);
+    head.write_4_bytes_little_endian(sink.checksum());
+    return true;
+}
+
 /// Serialize a message object to the Bitcoin wire protocol encoding.
+/// Returns an empty buffer if the message could not be written.
 template <typename Message>
 data_chunk serialize(uint32_t version, const Message& packet,
     uint32_t magic)
 {
-    const auto heading_size = heading::satoshi_fixed_size();
-    const auto payload_size = packet.serialized_size(version);
-    const auto message_size = heading_size + payload_size;
-
-    // Unfortunately data_sink doesn't support seek, so this is a little ugly.
-    // The header requires payload size and checksum but prepends the payload.
-    // Use a stream to prevent unnecessary copying of the payload.
     data_chunk data;
+    const auto payload_size = packet.serialized_size(version);
+    const auto payload = [&](writer& sink)
+    {
+        packet.to_data(version, sink);
+    };
 
-    // Reserve memory for the full message.
-    data.reserve(message_size);
-
-    // Size the vector for the heading so that payload insertion will follow.
-    data.resize(heading_size);
+    if (!write_message(data, Message::command, magic, payload_size, payload))
+        return {};
 
-    // Insert the payload after the heading and into the reservation.
-    data_sink ostream(data);
-    packet.to_data(version, ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == message_size);
+    return data;
+}
 
-    // Create the payload checksum without copying the buffer.
-    data_slice slice(data.data() + heading_size, data.data() + message_size);
-    const auto check = bitcoin_checksum(slice);
-    const auto payload_size32 = safe_unsigned<uint32_t>(payload_size);
+/// Serialize into a buffer drawn from the pool, to be released once sent.
+/// Returns an empty buffer if the message could not be written.
+template <typename Message>
+data_chunk serialize(uint32_t version, const Message& packet,
+    uint32_t magic, buffer_pool& pool)
+{
+    const auto payload_size = packet.serialized_size(version);
+    auto data = pool.acquire(heading::satoshi_fixed_size() + payload_size);
+    const auto payload = [&](writer& sink)
+    {
+        packet.to_data(version, sink);
+    };
 
-    // Create and serialize the heading to a temporary variable (12 bytes).
-    heading head(magic, Message::command, payload_size32, check);
-    auto heading = head.to_data();
+    if (!write_message(data, Message::command, magic, payload_size, payload))
+        return {};
 
-    // Move the heading into the allocated beginning of the message buffer.
-    std::move(heading.begin(), heading.end(), data.begin());
     return data;
 }
 
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_ROLLING_FILTER_HPP
+#define LIBBITCOIN_MESSAGE_ROLLING_FILTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/message/inventory_vector.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// A rolling bloom filter of inventory known to a peer, for relay suppression.
+/// Insertions are grouped into three generations, each half of the capacity,
+/// and the oldest generation is cleared as a new one starts. So at least the
+/// most recent capacity insertions are always retained, in fixed memory.
+/// Elements are hashed with siphash under a random key, so that filter
+/// collisions cannot be targeted by peers. The witness flag of the inventory
+/// type is ignored. This class is not thread safe.
+class BC_API rolling_filter
+{
+public:
+    /// Capacity is the minimum number of most recent insertions retained.
+    rolling_filter(size_t capacity, double false_positive_rate);
+    rolling_filter(size_t capacity, double false_positive_rate,
+        const siphash_key& key);
+
+    /// Add the inventory to the filter, amortized constant time.
+    void insert(const inventory_vector& inventory);
+
+    /// The inventory is (probably) in the filter, constant time.
+    bool contains(const inventory_vector& inventory) const;
+
+    /// Clear the filter, retaining its size and key.
+    void reset();
+
+    size_t hash_functions() const;
+
+    /// The size of the filter in bytes.
+    size_t size() const;
+
+private:
+    uint64_t hash(const inventory_vector& inventory) const;
+    size_t position(uint32_t value) const;
+    void roll();
+
+    const siphash_key key_;
+    const size_t generation_capacity_;
+    size_t hash_functions_;
+    size_t generation_size_;
+    uint8_t generation_;
+
+    // Each bit of a pair of words encodes the generation (1..3) of a bit.
+    std::vector<uint64_t> data_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
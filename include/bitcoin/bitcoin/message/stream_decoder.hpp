@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MESSAGE_STREAM_DECODER_HPP
+#define LIBBITCOIN_MESSAGE_STREAM_DECODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/message/heading.hpp>
+#include <bitcoin/bitcoin/utility/buffer_pool.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+/// Incremental decoder of the framed message stream of a single connection.
+/// Socket reads of any size are consumed as they arrive. Each message heading
+/// is validated against the magic, maximum payload size and payload checksum
+/// and the payload is handed out as a slice. Slices reference the read buffer
+/// wherever a message part lies within a single read, otherwise they reference
+/// an internal buffer whose capacity is retained if small, so small messages
+/// are not allocated individually. This class is not thread safe.
+class BC_API stream_decoder
+  : noncopyable
+{
+public:
+    /// The payload is valid only for the duration of the call. Return an
+    /// error code to stop decoding, which is then returned from decode.
+    typedef std::function<code(const heading&, data_slice)> handler;
+
+    /// Deserialize a message from a payload slice without copying it.
+    template <typename Message>
+    static bool parse(Message& out, uint32_t version, data_slice payload)
+    {
+        auto source = make_safe_deserializer(payload.begin(), payload.end());
+        return out.from_data(version, source);
+    }
+
+    stream_decoder(uint32_t magic, uint32_t version, bool witness);
+
+    /// Buffers are drawn from the pool by class as message bytes arrive, and
+    /// those larger than the small message class are returned to it once the
+    /// message is handled. The pool must outlive the decoder.
+    stream_decoder(uint32_t magic, uint32_t version, bool witness,
+        buffer_pool& pool);
+
+    ~stream_decoder();
+
+    /// Decode all complete messages in the data, retaining any partial
+    /// message. Returns error::bad_stream on an invalid heading or checksum,
+    /// after which the stream cannot be resynchronized and must be dropped.
+    code decode(data_slice data, handler handler);
+
+    /// The number of bytes of the current message part that are buffered.
+    size_t buffered() const;
+
+    /// The capacity of the internal buffer, retained only up to that of the
+    /// small buffer class once a message is handled.
+    size_t capacity() const;
+
+    /// Discard any partial message and release the buffer.
+    void reset();
+
+private:
+    size_t required() const;
+    code consume(data_slice part, handler& handler);
+    code dispatch(data_slice payload, handler& handler);
+    void reserve(size_t size);
+    void recycle();
+
+    const uint32_t magic_;
+    const size_t maximum_payload_;
+    heading heading_;
+    bool have_heading_;
+    data_chunk buffer_;
+    buffer_pool* const pool_;
+};
+
+} // namespace message
+} // namespace libbitcoin
+
+#endif
@@ -30,6 +30,7 @@
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -44,6 +45,7 @@ public:
     typedef std::vector<const_ptr> const_ptr_list;
     typedef std::shared_ptr<const_ptr_list> const_ptr_list_ptr;
     typedef std::shared_ptr<const_ptr_list> const_ptr_list_const_ptr;
+    typedef std::shared_ptr<const data_chunk> wire_ptr;
 
     static transaction factory(uint32_t version, const data_chunk& data);
     static transaction factory(uint32_t version, std::istream& stream);
@@ -70,6 +72,13 @@ public:
     void to_data(uint32_t version, writer& sink) const;
     size_t serialized_size(uint32_t version) const;
 
+    /// The wire encoding (heading and payload), serialized once for the
+    /// protocol version, network magic and witness mode and then shared by
+    /// sends that match them. Any modification of the transaction discards it.
+    /// Returns an empty encoding if the message could not be written.
+    wire_ptr to_wire(uint32_t version, uint32_t magic,
+        bool witness=true) const;
+
     transaction& operator=(chain::transaction&& other);
 
     /// This class is move assignable but not copy assignable.
@@ -86,6 +95,17 @@ public:
     static const std::string command;
     static const uint32_t version_minimum;
     static const uint32_t version_maximum;
+
+private:
+    void invalidate_wire() const;
+
+    // These share a mutex as they are not expected to contend.
+    mutable uint32_t wire_revision_;
+    mutable uint32_t wire_version_;
+    mutable uint32_t wire_magic_;
+    mutable bool wire_witness_;
+    mutable wire_ptr wire_;
+    mutable upgrade_mutex wire_mutex_;
 };
 
 } // namespace message
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_BUFFER_POOL_HPP
+#define LIBBITCOIN_BUFFER_POOL_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+/// A thread safe pool of message buffers, recycled by capacity class. The
+/// classes are sized for small messages (inv, ping, addr), transactions and
+/// blocks. Each class retains a bounded number of buffers of exactly its
+/// capacity (as acquired), and buffers of any other capacity are discarded on
+/// release, so retained memory is bounded by the class limits. Sizes above the
+/// transaction class and up to half of the block class are allocated exactly
+/// and not retained, so that a large transaction does not pin a block buffer.
+class BC_API buffer_pool
+  : noncopyable
+{
+public:
+    struct statistics
+    {
+        /// Acquisitions satisfied by a retained buffer.
+        size_t hits;
+
+        /// Acquisitions that required an allocation.
+        size_t misses;
+
+        /// Released buffers retained for reuse.
+        size_t recycled;
+
+        /// Released buffers freed (not of a class capacity or class full).
+        size_t discarded;
+
+        /// Buffers currently retained and their total capacity in bytes.
+        size_t retained;
+        size_t retained_bytes;
+
+        /// The ratio of hits to acquisitions, zero if none.
+        double hit_rate() const;
+    };
+
+    /// Buffer capacity of the small message, transaction and block classes.
+    static const size_t small_capacity;
+    static const size_t transaction_capacity;
+    static const size_t block_capacity;
+
+    buffer_pool();
+
+    /// An empty buffer with at least the given capacity, reusing a retained
+    /// buffer of the smallest sufficient class if possible. Sizes between the
+    /// transaction and block classes may have exactly the given capacity.
+    data_chunk acquire(size_t size);
+
+    /// Return a buffer to the pool once it is no longer used.
+    void release(data_chunk&& buffer);
+
+    /// Free all retained buffers, statistics are preserved.
+    void clear();
+
+    statistics stats() const;
+
+private:
+    struct size_class
+    {
+        size_t capacity;
+        size_t limit;
+        std::vector<data_chunk> buffers;
+        mutable shared_mutex mutex;
+    };
+
+    typedef std::array<size_class, 3> size_classes;
+
+    size_class* acquire_class(size_t size);
+    size_class* release_class(size_t capacity);
+
+    size_classes classes_;
+    std::atomic<size_t> hits_;
+    std::atomic<size_t> misses_;
+    std::atomic<size_t> recycled_;
+    std::atomic<size_t> discarded_;
+};
+
+} // namespace libbitcoin
+
+#endif
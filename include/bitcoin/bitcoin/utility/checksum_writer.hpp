@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHECKSUM_WRITER_HPP
+#define LIBBITCOIN_CHECKSUM_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+#include <bitcoin/bitcoin/utility/writer.hpp>
+
+namespace libbitcoin {
+
+/// Writer to a preallocated buffer that accumulates the bitcoin checksum of
+/// the written bytes, so that the buffer is not read back for hashing.
+/// Writing beyond the end of the buffer invalidates the writer.
+class BC_API checksum_writer
+  : public writer, noncopyable
+{
+public:
+    /// Write in place over the range [begin, end).
+    checksum_writer(uint8_t* begin, uint8_t* end);
+
+    /// Append up to size bytes to the chunk, which is never zero filled.
+    checksum_writer(data_chunk& chunk, size_t size);
+
+    /// Context.
+    operator bool() const;
+    bool operator!() const;
+
+    /// Write hashes.
+    void write_hash(const hash_digest& value);
+    void write_short_hash(const short_hash& value);
+    void write_mini_hash(const mini_hash& value);
+
+    /// Write big endian integers.
+    void write_2_bytes_big_endian(uint16_t value);
+    void write_4_bytes_big_endian(uint32_t value);
+    void write_8_bytes_big_endian(uint64_t value);
+    void write_variable_big_endian(uint64_t value);
+    void write_size_big_endian(size_t value);
+
+    /// Write little endian integers.
+    void write_2_bytes_little_endian(uint16_t value);
+    void write_4_bytes_little_endian(uint32_t value);
+    void write_8_bytes_little_endian(uint64_t value);
+    void write_variable_little_endian(uint64_t value);
+    void write_size_little_endian(size_t value);
+
+    /// Write one byte.
+    void write_byte(uint8_t value);
+
+    /// Write all bytes.
+    void write_bytes(const data_slice data);
+
+    /// Write required size buffer.
+    void write_bytes(const uint8_t* data, size_t size);
+
+    /// Write variable length string.
+    void write_string(const std::string& value);
+
+    /// Write required length string, padded with nulls.
+    void write_string(const std::string& value, size_t size);
+
+    /// Advance without writing, the skipped bytes are included in the hash.
+    void skip(size_t size);
+
+    // non-interface
+    //-------------------------------------------------------------------------
+
+    /// The number of bytes written (or skipped).
+    size_t size() const;
+
+    /// The bitcoin checksum of the bytes written, call once when complete.
+    uint32_t checksum();
+
+private:
+    // Sized to the sha256 context, which is private to the implementation.
+    typedef std::aligned_storage<104, sizeof(uint32_t)>::type context;
+
+    size_t remaining() const;
+
+    bool valid_;
+    uint8_t* const begin_;
+    uint8_t* const end_;
+    uint8_t* position_;
+    data_chunk* const chunk_;
+    const size_t start_;
+    const size_t limit_;
+    context context_;
+};
+
+} // namespace libbitcoin
+
+#endif
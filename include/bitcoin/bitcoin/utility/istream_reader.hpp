@@ -80,6 +80,9 @@ public:
     /// Read required size buffer.
     data_chunk read_bytes(size_t size);
 
+    /// Read required size into the caller's buffer.
+    void read_bytes(uint8_t* buffer, size_t size);
+
     /// Read variable length string.
     std::string read_string();
 
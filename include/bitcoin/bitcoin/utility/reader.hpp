@@ -68,6 +68,9 @@ public:
     /// Read required size buffer.
     virtual data_chunk read_bytes(size_t size) = 0;
 
+    /// Read required size into the caller's buffer.
+    virtual void read_bytes(uint8_t* buffer, size_t size) = 0;
+
     /// Read variable length string.
     virtual std::string read_string() = 0;
 
@@ -116,6 +116,14 @@ private:
     bool shutdown_;
 };
 
+/**
+ * Run job(index) for each index in [0, count) on the pool, returning once all
+ * have completed. The calling thread also runs jobs, so this completes when
+ * called from a pool thread or when the pool has no threads.
+ */
+BC_API void parallel_for(threadpool& pool, size_t count,
+    std::function<void(size_t)> job);
+
 } // namespace libbitcoin
 
 #endif
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_WALLET_NEUTRINO_HPP
+#define LIBBITCOIN_WALLET_NEUTRINO_HPP
+
+#include <cstdint>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+/**
+ * BIP158 basic filter Golomb-Rice parameters (P and M).
+ */
+static BC_CONSTEXPR uint8_t neutrino_filter_bits = 19;
+static BC_CONSTEXPR uint64_t neutrino_filter_rate = 784931;
+
+/**
+ * Compute the BIP158 basic filter of a block, from its output scripts and
+ * the scripts of the previous outputs it spends, which must be populated
+ * (output_point::validation::cache). Returns false if any is missing.
+ */
+BC_API bool compute_filter(chain::block& block, data_chunk& out_filter);
+
+/**
+ * Compute the filter header, chained from the previous block filter header.
+ */
+BC_API hash_digest compute_filter_header(const hash_digest& previous_header,
+    data_slice filter);
+
+/**
+ * The script is (probably) in the filter of the identified block.
+ */
+BC_API bool match_filter(const hash_digest& block_hash, data_slice filter,
+    const chain::script& script);
+
+/**
+ * Any of the scripts is (probably) in the filter of the identified block.
+ * The filter is decoded once, merged against all of the scripts.
+ */
+BC_API bool match_filter(const hash_digest& block_hash, data_slice filter,
+    const data_stack& scripts);
+
+} // namespace wallet
+} // namespace libbitcoin
+
+#endif
@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <limits>
 #include <cfenv>
 #include <cmath>
@@ -51,6 +52,7 @@
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -64,25 +66,32 @@ using namespace boost::adaptors;
 
 block::block()
   : header_(),
-    metadata{}
+    metadata{},
+    revision_(0)
 {
 }
 
 block::block(const block& other)
   : total_inputs_(other.total_inputs_cache()),
     non_coinbase_inputs_(other.non_coinbase_inputs_cache()),
+    base_size_(other.base_size_cache()),
+    total_size_(other.total_size_cache()),
     header_(other.header_),
     transactions_(other.transactions_),
-    metadata(other.metadata)
+    metadata(other.metadata),
+    revision_(0)
 {
 }
 
 block::block(block&& other)
   : total_inputs_(other.total_inputs_cache()),
     non_coinbase_inputs_(other.non_coinbase_inputs_cache()),
+    base_size_(other.base_size_cache()),
+    total_size_(other.total_size_cache()),
     header_(std::move(other.header_)),
     transactions_(std::move(other.transactions_)),
-    metadata(other.metadata)
+    metadata(other.metadata),
+    revision_(0)
 {
 }
 
@@ -90,14 +99,16 @@ block::block(const chain::header& header,
     const transaction::list& transactions)
   : header_(header),
     transactions_(transactions),
-    metadata{}
+    metadata{},
+    revision_(0)
 {
 }
 
 block::block(chain::header&& header, transaction::list&& transactions)
   : header_(std::move(header)),
     transactions_(std::move(transactions)),
-    metadata{}
+    metadata{},
+    revision_(0)
 {
 }
 
@@ -113,6 +124,18 @@ block::optional_size block::non_coinbase_inputs_cache() const
     return non_coinbase_inputs_;
 }
 
+block::optional_size block::base_size_cache() const
+{
+    shared_lock lock(mutex_);
+    return base_size_;
+}
+
+block::optional_size block::total_size_cache() const
+{
+    shared_lock lock(mutex_);
+    return total_size_;
+}
+
 // Operators.
 //-----------------------------------------------------------------------------
 
@@ -120,9 +143,12 @@ block& block::operator=(block&& other)
 {
     total_inputs_ = other.total_inputs_cache();
     non_coinbase_inputs_ = other.non_coinbase_inputs_cache();
+    base_size_ = other.base_size_cache();
+    total_size_ = other.total_size_cache();
     header_ = std::move(other.header_);
     transactions_ = std::move(other.transactions_);
     metadata = std::move(other.metadata);
+    ++revision_;
     return *this;
 }
 
@@ -204,6 +230,13 @@ bool block::from_data(reader& source, bool witness)
     if (!source)
         reset();
 
+    // Sum the cached tx sizes now so that size and weight limits are O(1).
+    if (source)
+    {
+        serialized_size(false);
+        serialized_size(true);
+    }
+
     metadata.end_deserialize = asio::steady_clock::now();
     return source;
 }
@@ -214,9 +247,10 @@ void block::reset()
     header_.reset();
     transactions_.clear();
     transactions_.shrink_to_fit();
+    invalidate_cache();
 }
 
-bool block::is_valid()
+bool block::is_valid() const
 {
     return !transactions_.empty() || header_.is_valid();
 }
@@ -230,7 +264,7 @@ data_chunk block::to_data(bool witness) const
     const auto size = serialized_size(witness);
     data.reserve(size);
     data_sink ostream(data);
-    to_data(ostream);
+    to_data(ostream, witness);
     ostream.flush();
     BITCOIN_ASSERT(data.size() == size);
     return data;
@@ -321,50 +355,84 @@ size_t block::serialized_size(bool witness) const
     return value;
 }
 
- chain::header& block::header()
+chain::header& block::header()
 {
+    // The header may be modified through the reference.
+    invalidate_cache();
     return header_;
 }
 
-void block::set_header( chain::header& value)
+const chain::header& block::header() const
+{
+    return header_;
+}
+
+void block::set_header(const chain::header& value)
 {
     header_ = value;
+    invalidate_cache();
 }
 
 void block::set_header(chain::header&& value)
 {
     header_ = std::move(value);
+    invalidate_cache();
 }
 
- transaction::list& block::transactions() 
+transaction::list& block::transactions()
 {
+    // The transactions may be modified through the reference.
+    invalidate_cache();
     return transactions_;
 }
 
-void block::set_transactions( transaction::list& value)
+const transaction::list& block::transactions() const
+{
+    return transactions_;
+}
+
+void block::set_transactions(const transaction::list& value)
 {
     transactions_ = value;
-    segregated_ = boost::none;
-    total_inputs_ = boost::none;
-    non_coinbase_inputs_ = boost::none;
-    base_size_ = boost::none;
-    total_size_ = boost::none;
+    invalidate_cache();
 }
 
 void block::set_transactions(transaction::list&& value)
 {
     transactions_ = std::move(value);
+    invalidate_cache();
+}
+
+// Convenience property.
+hash_digest block::hash() const
+{
+    return header_.hash();
+}
+
+// Cache.
+//-----------------------------------------------------------------------------
+
+// protected
+void block::invalidate_cache() const
+{
+    ++revision_;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(mutex_);
+
     segregated_ = boost::none;
     total_inputs_ = boost::none;
     non_coinbase_inputs_ = boost::none;
     base_size_ = boost::none;
     total_size_ = boost::none;
+    ///////////////////////////////////////////////////////////////////////////
 }
 
-// Convenience property.
-hash_digest block::hash()
+// protected
+uint32_t block::revision() const
 {
-    return header_.hash();
+    return revision_;
 }
 
 // Utilities.
@@ -422,6 +490,9 @@ void block::strip_witness()
         transaction.strip_witness();
     };
 
+    // The witness encoding changes, along with any encoding derived from it.
+    invalidate_cache();
+
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
     unique_lock lock(mutex_);
@@ -450,9 +521,13 @@ uint64_t block::subsidy(size_t height, uint64_t subsidy_interval,
 size_t block::signature_operations()
 {
     const auto state = header_.metadata.state;
+
+    if (!state)
+        return max_size_t;
+
     const auto bip16 = state->is_enabled(rule_fork::bip16_rule);
     const auto bip141 = state->is_enabled(rule_fork::bip141_rule);
-    return state ? signature_operations(bip16, bip141) : max_size_t;
+    return signature_operations(bip16, bip141);
 }
 
 // Returns max_size_t in case of overflow.
@@ -491,12 +566,12 @@ size_t block::total_non_coinbase_inputs()
     mutex_.unlock_upgrade_and_lock();
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
-     auto inputs = [](size_t total,  transaction& tx)
+    const auto inputs = [](size_t total, const transaction& tx)
     {
         return safe_add(total, tx.inputs().size());
     };
 
-     auto& txs = transactions_;
+    const auto& txs = transactions_;
     value = std::accumulate(txs.begin() + 1, txs.end(), size_t(0), inputs);
     non_coinbase_inputs_ = value;
 
@@ -525,12 +600,12 @@ size_t block::total_inputs()
     mutex_.unlock_upgrade_and_lock();
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
-     auto inputs = [](size_t total,  transaction& tx)
+    const auto inputs = [](size_t total, const transaction& tx)
     {
         return safe_add(total, tx.inputs().size());
     };
 
-     auto& txs = transactions_;
+    const auto& txs = transactions_;
     value = std::accumulate(txs.begin(), txs.end(), size_t(0), inputs);
     total_inputs_ = value;
 
@@ -586,7 +661,7 @@ bool block::is_distinct_transaction_set()
     return distinct_end == hashes.end();
 }
 
-hash_digest block::generate_merkle_root(bool witness)
+hash_digest block::generate_merkle_root(bool witness) const
 {
     if (transactions_.empty())
         return null_hash;
@@ -604,7 +679,7 @@ hash_digest block::generate_merkle_root(bool witness)
             merkle.push_back(merkle.back());
 
         for (auto it = merkle.begin(); it != merkle.end(); it += 2)
-            update.push_back(bitcoin_hash(build_chunk({ it[0], it[1] })));
+            update.push_back(bitcoin_hash({ it[0], it[1] }));
 
         std::swap(merkle, update);
         update.clear();
@@ -626,7 +701,7 @@ bool block::is_forward_reference()
         return hashes.count(input.previous_output().hash()) != 0;
     };
 
-    for ( auto& tx: reverse(transactions_))
+    for (const auto& tx: reverse(transactions_))
     {
         hashes.emplace(tx.hash(), true);
 
@@ -702,24 +777,32 @@ bool block::is_valid_coinbase_claim(size_t height, uint64_t subsidy_interval,
 
 bool block::is_valid_coinbase_script(size_t height)
 {
-    if (transactions_.empty() || transactions_.front().inputs().empty())
+    if (transactions_.empty())
+        return false;
+
+    const auto& coinbase = transactions_.front();
+
+    if (coinbase.inputs().empty())
         return false;
 
-     auto& script = transactions_.front().inputs().front().script();
+    const auto& script = coinbase.inputs().front().script();
     return script::is_coinbase_pattern(script.operations(), height);
 }
 
 bool block::is_valid_witness_commitment()
 {
-    if (transactions_.empty() || transactions_.front().inputs().empty())
+    if (transactions_.empty())
         return false;
 
     hash_digest reserved, committed;
-     auto& coinbase = transactions_.front();
+    const auto& coinbase = transactions_.front();
+
+    if (coinbase.inputs().empty())
+        return false;
 
     // Last output of commitment pattern holds committed value (bip141).
     if (coinbase.inputs().front().extract_reserved_hash(reserved))
-        for ( auto& output: reverse(coinbase.outputs()))
+        for (const auto& output: reverse(coinbase.outputs()))
             if (output.extract_committed_hash(committed))
                 return committed == bitcoin_hash(
                     build_chunk({ generate_merkle_root(true), reserved }));
@@ -772,6 +855,16 @@ code block::check_transactions(uint64_t max_money)
     return error::success;
 }
 
+// Returns the first failure in transaction order, independent of scheduling.
+code block::check_transactions(uint64_t max_money, threadpool& pool)
+{
+    for (const auto& ec: check_each_transaction(max_money, pool))
+        if (ec)
+            return ec;
+
+    return error::success;
+}
+
 code block::accept_transactions(const chain_state& state)
 {
     code ec;
@@ -805,6 +898,52 @@ code block::check(uint64_t max_money, uint32_t timestamp_limit_seconds,
 
     code ec;
 
+    if ((ec = check_structure(timestamp_limit_seconds, proof_of_work_limit,
+        scrypt)))
+        return ec;
+
+    else if ((ec = check_transaction_set()))
+        return ec;
+
+    else
+        return check_transactions(max_money);
+}
+
+// The structural checks are cheap, so they reject a block before any
+// transaction work. Transaction checks are then run on the pool, along with
+// the transaction hashing and sigop counting that the remaining block checks
+// would otherwise do serially. Results are evaluated in the serial order, so
+// the first error is unchanged.
+code block::check(uint64_t max_money, uint32_t timestamp_limit_seconds,
+    uint32_t proof_of_work_limit, threadpool& pool, bool scrypt)
+{
+    metadata.start_check = asio::steady_clock::now();
+
+    code ec;
+
+    if ((ec = check_structure(timestamp_limit_seconds, proof_of_work_limit,
+        scrypt)))
+        return ec;
+
+    const auto results = check_each_transaction(max_money, pool);
+
+    if ((ec = check_transaction_set()))
+        return ec;
+
+    for (const auto& result: results)
+        if (result)
+            return result;
+
+    return error::success;
+}
+
+// private
+// Header and block structure, independent of transaction contents.
+code block::check_structure(uint32_t timestamp_limit_seconds,
+    uint32_t proof_of_work_limit, bool scrypt)
+{
+    code ec;
+
     if ((ec = header_.check(timestamp_limit_seconds, proof_of_work_limit,
         scrypt)))
         return ec;
@@ -822,8 +961,16 @@ code block::check(uint64_t max_money, uint32_t timestamp_limit_seconds,
     else if (is_extra_coinbases())
         return error::extra_coinbases;
 
+    else
+        return error::success;
+}
+
+// private
+// Relations among the transactions, these use the tx hash and sigop caches.
+code block::check_transaction_set()
+{
     // TODO: determinable from tx pool graph.
-    else if (is_forward_reference())
+    if (is_forward_reference())
         return error::forward_reference;
 
     // This is subset of is_internal_double_spend if collisions cannot happen.
@@ -842,11 +989,32 @@ code block::check(uint64_t max_money, uint32_t timestamp_limit_seconds,
     // This will not make a difference unless prevouts are populated, in which
     // case they are ignored. This means that p2sh sigops are not counted here.
     // This is a preliminary check, the final count must come from connect().
-    ////else if (signature_operations(false, false) > max_block_sigops)
-    ////    return error::block_legacy_sigop_limit;
+    else if (signature_operations(false, false) > max_block_sigops)
+        return error::block_legacy_sigop_limit;
 
     else
-        return check_transactions(max_money);
+        return error::success;
+}
+
+// private
+// Each job also populates the tx hash and legacy sigop caches, which are
+// thread safe, so that the subsequent merkle and sigop checks are cheap.
+block::code_list block::check_each_transaction(uint64_t max_money,
+    threadpool& pool)
+{
+    code_list results(transactions_.size(), error::success);
+    auto& txs = transactions_;
+
+    const auto job = [&txs, &results, max_money](size_t index)
+    {
+        auto& tx = txs[index];
+        tx.hash(false);
+        tx.signature_operations(false, false);
+        results[index] = tx.check(max_money, false);
+    };
+
+    parallel_for(pool, txs.size(), job);
+    return results;
 }
 
 code block::accept( bc::settings& settings, bool transactions, bool header)
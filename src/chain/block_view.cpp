@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/block_view.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/transaction_view.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/message/messages.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+block_view::block_view()
+  : begin_(nullptr), size_(0)
+{
+}
+
+block_view::block_view(block_view&& other)
+  : begin_(other.begin_),
+    size_(other.size_),
+    transactions_(std::move(other.transactions_))
+{
+}
+
+block_view::block_view(const block_view& other)
+  : begin_(other.begin_),
+    size_(other.size_),
+    transactions_(other.transactions_)
+{
+}
+
+block_view::block_view(data_slice data)
+  : block_view()
+{
+    from_data(data);
+}
+
+// Operators.
+//-----------------------------------------------------------------------------
+
+block_view& block_view::operator=(block_view&& other)
+{
+    begin_ = other.begin_;
+    size_ = other.size_;
+    transactions_ = std::move(other.transactions_);
+    return *this;
+}
+
+block_view& block_view::operator=(const block_view& other)
+{
+    begin_ = other.begin_;
+    size_ = other.size_;
+    transactions_ = other.transactions_;
+    return *this;
+}
+
+// Deserialization.
+//-----------------------------------------------------------------------------
+
+// Offsets are relative to begin, the list is terminated by its end offset.
+bool block_view::from_data(data_slice data)
+{
+    reset();
+    const auto begin = data.begin();
+    const auto end = data.end();
+    const auto header_size = header::satoshi_fixed_size();
+
+    if (data.size() < header_size)
+        return false;
+
+    auto source = make_safe_deserializer(begin + header_size, end);
+    const auto count = source.read_size_little_endian();
+
+    // Guard against potential for arbitary memory allocation.
+    if (!source || count > max_block_size)
+        return false;
+
+    auto offset = header_size + message::variable_uint_size(count);
+    transactions_.reserve(count + 1);
+
+    for (size_t tx = 0; tx < count; ++tx)
+    {
+        transactions_.push_back(offset);
+        const auto size = transaction_view::measure({ begin + offset, end });
+
+        if (size == 0)
+        {
+            reset();
+            return false;
+        }
+
+        offset += size;
+    }
+
+    transactions_.push_back(offset);
+
+    // Full block deserialization is always canonical encoding.
+    if (offset != data.size())
+    {
+        reset();
+        return false;
+    }
+
+    begin_ = begin;
+    size_ = offset;
+    return true;
+}
+
+// protected
+void block_view::reset()
+{
+    begin_ = nullptr;
+    size_ = 0;
+    transactions_.clear();
+}
+
+bool block_view::is_valid() const
+{
+    return begin_ != nullptr;
+}
+
+// Properties (size, accessors).
+//-----------------------------------------------------------------------------
+
+data_slice block_view::data() const
+{
+    return { begin_, begin_ + size_ };
+}
+
+size_t block_view::serialized_size() const
+{
+    return size_;
+}
+
+chain::header block_view::header() const
+{
+    if (!is_valid())
+        return{};
+
+    const auto end = begin_ + header::satoshi_fixed_size();
+    auto source = make_safe_deserializer(begin_, end);
+    return header::factory(source, true);
+}
+
+hash_digest block_view::hash() const
+{
+    if (!is_valid())
+        return null_hash;
+
+    return bitcoin_hash(data_slice{ begin_, begin_ +
+        header::satoshi_fixed_size() });
+}
+
+size_t block_view::transactions_size() const
+{
+    return transactions_.empty() ? 0 : transactions_.size() - 1;
+}
+
+data_slice block_view::transaction_data(size_t index) const
+{
+    BITCOIN_ASSERT(index < transactions_size());
+    return
+    {
+        begin_ + transactions_[index],
+        begin_ + transactions_[index + 1]
+    };
+}
+
+transaction_view block_view::transaction(size_t index) const
+{
+    return { transaction_data(index) };
+}
+
+hash_list block_view::to_hashes(bool witness) const
+{
+    hash_list out;
+    const auto count = transactions_size();
+    out.reserve(count);
+
+    // Hash ordering matters, don't use std::transform here.
+    for (size_t index = 0; index < count; ++index)
+        out.push_back(transaction(index).hash(witness));
+
+    return out;
+}
+
+block block_view::to_block(bool witness) const
+{
+    const auto data = this->data();
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return block::factory(source, witness);
+}
+
+} // namespace chain
+} // namespace libbitcoin
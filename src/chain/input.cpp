@@ -485,12 +485,10 @@ bool input::extract_embedded_script(chain::script& out) const
 
 bool input::extract_reserved_hash(hash_digest& out) const
 {
-    const auto& stack = witness_.stack();
-
-    if (!witness::is_reserved_pattern(stack))
+    if (!witness_.is_reserved_pattern())
         return false;
 
-    std::copy_n(stack.front().begin(), hash_size, out.begin());
+    std::copy_n(witness_.front().begin(), hash_size, out.begin());
     return true;
 }
 
@@ -70,6 +70,12 @@ static const auto one_hash = hash_literal(
 // A default instance is invalid (until modified).
 script::script()
   : cached_(false),
+    tokenized_(false),
+    legacy_sigops_(0),
+    accurate_sigops_(0),
+    output_pattern_(script_pattern::non_standard),
+    input_pattern_(script_pattern::non_standard),
+    version_(script_version::unversioned),
     valid_(false)
 {
 }
@@ -77,6 +83,14 @@ script::script()
 script::script(script&& other)
   : operations_(std::move(other.operations_move())),
     cached_(!operations_.empty()),
+    tokens_(std::move(other.tokens_move())),
+    tokenized_(!tokens_.empty()),
+    branches_(std::move(other.branches_)),
+    legacy_sigops_(other.legacy_sigops_),
+    accurate_sigops_(other.accurate_sigops_),
+    output_pattern_(other.output_pattern_),
+    input_pattern_(other.input_pattern_),
+    version_(other.version_),
     bytes_(std::move(other.bytes_)),
     valid_(other.valid_)
 {
@@ -85,22 +99,54 @@ script::script(script&& other)
 script::script(const script& other)
   : operations_(other.operations_copy()),
     cached_(!operations_.empty()),
+    tokens_(other.tokens_copy()),
+    tokenized_(!tokens_.empty()),
+    branches_(other.branches_),
+    legacy_sigops_(other.legacy_sigops_),
+    accurate_sigops_(other.accurate_sigops_),
+    output_pattern_(other.output_pattern_),
+    input_pattern_(other.input_pattern_),
+    version_(other.version_),
     bytes_(other.bytes_),
     valid_(other.valid_)
 {
 }
 
 script::script(const operation::list& ops)
+  : cached_(false),
+    tokenized_(false),
+    legacy_sigops_(0),
+    accurate_sigops_(0),
+    output_pattern_(script_pattern::non_standard),
+    input_pattern_(script_pattern::non_standard),
+    version_(script_version::unversioned),
+    valid_(false)
 {
     from_operations(ops);
 }
 
 script::script(operation::list&& ops)
+  : cached_(false),
+    tokenized_(false),
+    legacy_sigops_(0),
+    accurate_sigops_(0),
+    output_pattern_(script_pattern::non_standard),
+    input_pattern_(script_pattern::non_standard),
+    version_(script_version::unversioned),
+    valid_(false)
 {
     from_operations(std::move(ops));
 }
 
 script::script(data_chunk&& encoded, bool prefix)
+  : cached_(false),
+    tokenized_(false),
+    legacy_sigops_(0),
+    accurate_sigops_(0),
+    output_pattern_(script_pattern::non_standard),
+    input_pattern_(script_pattern::non_standard),
+    version_(script_version::unversioned),
+    valid_(false)
 {
     if (prefix)
     {
@@ -110,11 +156,18 @@ script::script(data_chunk&& encoded, bool prefix)
 
     // This is an optimization that avoids streaming the encoded bytes.
     bytes_ = std::move(encoded);
-    cached_ = false;
     valid_ = true;
 }
 
 script::script(const data_chunk& encoded, bool prefix)
+  : cached_(false),
+    tokenized_(false),
+    legacy_sigops_(0),
+    accurate_sigops_(0),
+    output_pattern_(script_pattern::non_standard),
+    input_pattern_(script_pattern::non_standard),
+    version_(script_version::unversioned),
+    valid_(false)
 {
     valid_ = from_data(encoded, prefix);
 }
@@ -133,6 +186,20 @@ const script::operation::list& script::operations_copy() const
     return operations_;
 }
 
+// Private cache access for move construction.
+script::token::list& script::tokens_move()
+{
+    shared_lock lock(mutex_);
+    return tokens_;
+}
+
+// Private cache access for copy construction.
+const script::token::list& script::tokens_copy() const
+{
+    shared_lock lock(mutex_);
+    return tokens_;
+}
+
 // Operators.
 //-----------------------------------------------------------------------------
 
@@ -141,6 +208,14 @@ script& script::operator=(script&& other)
 {
     operations_ = other.operations_move();
     cached_ = !operations_.empty();
+    tokens_ = std::move(other.tokens_move());
+    tokenized_ = !tokens_.empty();
+    branches_ = std::move(other.branches_);
+    legacy_sigops_ = other.legacy_sigops_;
+    accurate_sigops_ = other.accurate_sigops_;
+    output_pattern_ = other.output_pattern_;
+    input_pattern_ = other.input_pattern_;
+    version_ = other.version_;
     bytes_ = std::move(other.bytes_);
     valid_ = other.valid_;
     return *this;
@@ -151,6 +226,14 @@ script& script::operator=(const script& other)
 {
     operations_ = other.operations_copy();
     cached_ = !operations_.empty();
+    tokens_ = other.tokens_copy();
+    tokenized_ = !tokens_.empty();
+    branches_ = other.branches_;
+    legacy_sigops_ = other.legacy_sigops_;
+    accurate_sigops_ = other.accurate_sigops_;
+    output_pattern_ = other.output_pattern_;
+    input_pattern_ = other.input_pattern_;
+    version_ = other.version_;
     bytes_ = other.bytes_;
     valid_ = other.valid_;
     return *this;
@@ -259,6 +342,11 @@ void script::from_operations(operation::list&& ops)
     bytes_ = operations_to_data(ops);
     operations_ = std::move(ops);
     cached_ = true;
+    tokens_.clear();
+    tokenized_ = false;
+    branches_ = match_branches(operations_);
+    legacy_sigops_ = 0;
+    accurate_sigops_ = 0;
     valid_ = true;
 }
 
@@ -269,6 +357,11 @@ void script::from_operations(const operation::list& ops)
     bytes_ = operations_to_data(ops);
     operations_ = ops;
     cached_ = true;
+    tokens_.clear();
+    tokenized_ = false;
+    branches_ = match_branches(operations_);
+    legacy_sigops_ = 0;
+    accurate_sigops_ = 0;
     valid_ = true;
 }
 
@@ -308,8 +401,18 @@ void script::reset()
     bytes_.shrink_to_fit();
     valid_ = false;
     cached_ = false;
+    tokenized_ = false;
+    legacy_sigops_ = 0;
+    accurate_sigops_ = 0;
+    output_pattern_ = script_pattern::non_standard;
+    input_pattern_ = script_pattern::non_standard;
+    version_ = script_version::unversioned;
     operations_.clear();
     operations_.shrink_to_fit();
+    tokens_.clear();
+    tokens_.shrink_to_fit();
+    branches_.clear();
+    branches_.shrink_to_fit();
 }
 
 bool script::is_valid() const
@@ -432,6 +535,69 @@ size_t script::serialized_size(bool prefix) const
     return size;
 }
 
+// Parse the encoded script into tokens, or only count them if tokens is null.
+// A truncated final push is an invalid token, as it is parsed as an invalid op.
+static size_t tokenize(data_slice bytes, script::token::list* tokens)
+{
+    BC_CONSTEXPR auto op_75 = static_cast<uint8_t>(opcode::push_size_75);
+    BC_CONSTEXPR auto op_76 = static_cast<uint8_t>(opcode::push_one_size);
+    BC_CONSTEXPR auto op_77 = static_cast<uint8_t>(opcode::push_two_size);
+    BC_CONSTEXPR auto op_78 = static_cast<uint8_t>(opcode::push_four_size);
+
+    size_t count = 0;
+    const auto data = bytes.data();
+    const auto end = bytes.size();
+    const auto invalid = [tokens, &count]()
+    {
+        if (tokens != nullptr)
+            tokens->push_back({ opcode::disabled_xor, 0, 0, false });
+
+        return count + 1;
+    };
+
+    for (size_t offset = 0; offset < end; ++count)
+    {
+        const auto code = data[offset++];
+        const auto remaining = end - offset;
+        uint64_t size = 0;
+        size_t prefix = 0;
+
+        if (code <= op_75)
+            size = code;
+        else if (code == op_76)
+            prefix = sizeof(uint8_t);
+        else if (code == op_77)
+            prefix = sizeof(uint16_t);
+        else if (code == op_78)
+            prefix = sizeof(uint32_t);
+
+        if (prefix > remaining)
+            return invalid();
+
+        // The size prefix is little-endian.
+        for (size_t byte = 0; byte < prefix; ++byte)
+            size |= static_cast<uint64_t>(data[offset + byte]) << (8 * byte);
+
+        offset += prefix;
+
+        if (size > end - offset)
+            return invalid();
+
+        if (tokens != nullptr)
+            tokens->push_back(
+            {
+                static_cast<opcode>(code),
+                static_cast<uint32_t>(offset),
+                static_cast<uint32_t>(size),
+                true
+            });
+
+        offset += static_cast<size_t>(size);
+    }
+
+    return count;
+}
+
 // protected
 const operation::list& script::operations() const
 {
@@ -449,13 +615,12 @@ const operation::list& script::operations() const
     operation op;
     data_source istream(bytes_);
     istream_reader source(istream);
-    const auto size = bytes_.size();
 
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     mutex_.unlock_upgrade_and_lock();
 
-    // One operation per byte is the upper limit of operations.
-    operations_.reserve(size);
+    // Reserve the exact count so the list is allocated once.
+    operations_.reserve(tokenize(bytes_, nullptr));
 
     // ************************************************************************
     // CONSENSUS: In the case of a coinbase script we must parse the entire
@@ -473,7 +638,8 @@ const operation::list& script::operations() const
         operations_.push_back(std::move(op));
     }
 
-    operations_.shrink_to_fit();
+    // Conditional branches are matched and cached with the operations.
+    branches_ = match_branches(operations_);
     cached_ = true;
 
     mutex_.unlock();
@@ -482,6 +648,109 @@ const operation::list& script::operations() const
     return operations_;
 }
 
+const script::token::list& script::tokens() const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    mutex_.lock_upgrade();
+
+    if (tokenized_)
+    {
+        mutex_.unlock_upgrade();
+        //---------------------------------------------------------------------
+        return tokens_;
+    }
+
+    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    mutex_.unlock_upgrade_and_lock();
+
+    // Reserve the exact count so the list is allocated once.
+    tokens_.reserve(tokenize(bytes_, nullptr));
+    tokenize(bytes_, &tokens_);
+
+    // Sigops and patterns are computed in the parse critical section and
+    // cached with tokens.
+    legacy_sigops_ = count_sigops(tokens_, false);
+    accurate_sigops_ = count_sigops(tokens_, true);
+    output_pattern_ = classify_output(tokens_, bytes_);
+    input_pattern_ = classify_input(tokens_, bytes_);
+    version_ = classify_version(tokens_);
+    tokenized_ = true;
+
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    return tokens_;
+}
+
+// Branches are matched and cached when the operations are parsed.
+const script::branch::list& script::branches() const
+{
+    // The first operations access must be method-based to guarantee the cache.
+    operations();
+    return branches_;
+}
+
+// private/static
+// A branch is not skippable if unmatched or if a skipped operation would
+// fail if visited. Scripts without conditionals produce no allocation.
+script::branch::list script::match_branches(const operation::list& ops)
+{
+    // Each open branch is its entry and the counts following its opcode.
+    struct opened
+    {
+        size_t entry;
+        size_t counted;
+        size_t fatal;
+    };
+
+    branch::list branches;
+    std::vector<opened> open;
+    size_t counted = 0;
+    size_t fatal = 0;
+
+    for (size_t index = 0; index < ops.size(); ++index)
+    {
+        const auto& op = ops[index];
+        const auto code = op.code();
+        const auto closes = (code == opcode::else_ || code == opcode::endif);
+        const auto opens = (code == opcode::if_ || code == opcode::notif ||
+            (code == opcode::else_ && !open.empty()));
+
+        if (closes && !open.empty())
+        {
+            auto& branch = branches[open.back().entry];
+            branch.to = index;
+            branch.counted = counted - open.back().counted;
+            branch.skippable = (fatal == open.back().fatal);
+            open.pop_back();
+        }
+
+        counted += op.is_counted() ? 1 : 0;
+        fatal += (op.is_oversized() || op.is_disabled()) ? 1 : 0;
+
+        if (opens)
+        {
+            open.push_back({ branches.size(), counted, fatal });
+            branches.push_back({ index, 0, 0, false });
+        }
+    }
+
+    return branches;
+}
+
+data_slice script::payload(const token& token) const
+{
+    BITCOIN_ASSERT(token.offset + token.size <= bytes_.size());
+    const auto begin = bytes_.data() + token.offset;
+    return { begin, begin + token.size };
+}
+
+data_slice script::bytes() const
+{
+    return bytes_;
+}
+
 // Signing (unversioned).
 //-----------------------------------------------------------------------------
 
@@ -845,7 +1114,7 @@ hash_digest script::generate_signature_hash(const transaction& tx,
 
 // static
 bool script::check_signature(const ec_signature& signature,
-    uint8_t sighash_type, const data_chunk& public_key,
+    uint8_t sighash_type, data_slice public_key,
     const script& script_code, const transaction& tx, uint32_t input_index,
     script_version version, uint64_t value)
 {
@@ -1180,22 +1449,18 @@ operation::list script::to_pay_multisig_pattern(uint8_t signatures,
 
 data_chunk script::witness_program() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    const auto& ops = operations();
-    return is_witness_program_pattern(ops) ? ops[1].data() : data_chunk{};
+    return version() == script_version::unversioned ? data_chunk{} :
+        to_chunk(payload(tokens_[1]));
 }
 
+// The version is classified and cached when the tokens are parsed.
 script_version script::version() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    const auto& ops = operations();
-
-    if (!is_witness_program_pattern(ops))
-        return script_version::unversioned;
+    // The first tokens access must be method-based to guarantee the cache.
+    tokens();
 
-    // Version 0 is specified, others are reserved (bip141).
-    return (ops[0].code() == opcode::push_size_0) ? script_version::zero :
-        script_version::reserved;
+    shared_lock lock(mutex_);
+    return version_;
 }
 
 // Caller should test for is_sign_script_hash_pattern when sign_key_hash result
@@ -1208,81 +1473,207 @@ script_pattern script::pattern() const
 
 // Output patterns are mutually and input unambiguous.
 // The bip141 coinbase pattern is not tested here, must test independently.
+// The pattern is classified and cached when the tokens are parsed.
 script_pattern script::output_pattern() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    if (is_pay_key_hash_pattern(operations()))
+    // The first tokens access must be method-based to guarantee the cache.
+    tokens();
+
+    shared_lock lock(mutex_);
+    return output_pattern_;
+}
+
+// A sign_key_hash result always implies sign_script_hash as well.
+// The bip34 coinbase pattern is not tested here, must test independently.
+// The pattern is classified and cached when the tokens are parsed.
+script_pattern script::input_pattern() const
+{
+    // The first tokens access must be method-based to guarantee the cache.
+    tokens();
+
+    shared_lock lock(mutex_);
+    return input_pattern_;
+}
+
+data_slice script::output_payload() const
+{
+    // The first tokens access must be method-based to guarantee the cache.
+    const auto& tokens = this->tokens();
+
+    switch (output_pattern())
+    {
+        case script_pattern::pay_key_hash:
+            return payload(tokens[2]);
+        case script_pattern::pay_script_hash:
+        case script_pattern::pay_null_data:
+            return payload(tokens[1]);
+        case script_pattern::pay_public_key:
+            return payload(tokens[0]);
+        default:
+            break;
+    }
+
+    const auto begin = bytes_.data();
+    return version() == script_version::unversioned ?
+        data_slice{ begin, begin } : payload(tokens[1]);
+}
+
+// Classification (static).
+//-----------------------------------------------------------------------------
+// These mirror the operation pattern predicates over the in-place token parse,
+// so that a script may be classified without parsing its operations.
+
+// static
+script_pattern script::classify_output(data_slice bytes)
+{
+    token::list tokens;
+    tokens.reserve(tokenize(bytes, nullptr));
+    tokenize(bytes, &tokens);
+    return classify_output(tokens, bytes);
+}
+
+// static
+script_pattern script::classify_input(data_slice bytes)
+{
+    token::list tokens;
+    tokens.reserve(tokenize(bytes, nullptr));
+    tokenize(bytes, &tokens);
+    return classify_input(tokens, bytes);
+}
+
+// static
+script_version script::classify_version(data_slice bytes)
+{
+    token::list tokens;
+    tokens.reserve(tokenize(bytes, nullptr));
+    tokenize(bytes, &tokens);
+    return classify_version(tokens);
+}
+
+// private/static
+script_pattern script::classify_output(const token::list& tokens,
+    data_slice bytes)
+{
+    static BC_CONSTEXPR auto op_1 = static_cast<uint8_t>(
+        opcode::push_positive_1);
+    static BC_CONSTEXPR auto op_16 = static_cast<uint8_t>(
+        opcode::push_positive_16);
+
+    const auto count = tokens.size();
+    const auto code = [&tokens](size_t index)
+    {
+        return tokens[index].code;
+    };
+    const auto data = [&tokens, &bytes](size_t index)
+    {
+        const auto begin = bytes.data() + tokens[index].offset;
+        return data_slice{ begin, begin + tokens[index].size };
+    };
+
+    // is_pay_key_hash_pattern
+    if (count == 5 && code(0) == opcode::dup && code(1) == opcode::hash160 &&
+        tokens[2].size == short_hash_size && code(3) == opcode::equalverify &&
+        code(4) == opcode::checksig)
         return script_pattern::pay_key_hash;
 
-    if (is_pay_script_hash_pattern(operations_))
+    // is_pay_script_hash_pattern
+    if (count == 3 && code(0) == opcode::hash160 &&
+        code(1) == opcode::push_size_20 && code(2) == opcode::equal)
         return script_pattern::pay_script_hash;
 
-    if (is_pay_null_data_pattern(operations_))
+    // is_pay_null_data_pattern
+    if (count == 2 && code(0) == opcode::return_ &&
+        code(1) == operation::minimal_opcode_from_data(data(1)) &&
+        tokens[1].size <= max_null_data_size)
         return script_pattern::pay_null_data;
 
-    if (is_pay_public_key_pattern(operations_))
+    // is_pay_public_key_pattern
+    if (count == 2 && is_public_key(data(0)) && code(1) == opcode::checksig)
         return script_pattern::pay_public_key;
 
-    if (is_pay_multisig_pattern(operations_))
-        return script_pattern::pay_multisig;
+    // is_pay_multisig_pattern
+    if (count < 4 || code(count - 1) != opcode::checkmultisig)
+        return script_pattern::non_standard;
 
-    return script_pattern::non_standard;
+    const auto op_m = static_cast<uint8_t>(code(0));
+    const auto op_n = static_cast<uint8_t>(code(count - 2));
+
+    if (op_m < op_1 || op_m > op_n || op_n < op_1 || op_n > op_16 ||
+        op_n - op_1 + 1u != count - 3u)
+        return script_pattern::non_standard;
+
+    for (size_t index = 1; index < count - 2; ++index)
+        if (!is_public_key(data(index)))
+            return script_pattern::non_standard;
+
+    return script_pattern::pay_multisig;
 }
 
-// A sign_key_hash result always implies sign_script_hash as well.
-// The bip34 coinbase pattern is not tested here, must test independently.
-script_pattern script::input_pattern() const
+// private/static
+script_pattern script::classify_input(const token::list& tokens,
+    data_slice bytes)
 {
-    // The first operations access must be method-based to guarantee the cache.
-    if (is_sign_key_hash_pattern(operations()))
-        return script_pattern::sign_key_hash;
+    const auto count = tokens.size();
+    const auto is_endorsement = [&tokens](size_t index)
+    {
+        const auto size = tokens[index].size;
+        return size >= min_endorsement_size && size <= max_endorsement_size;
+    };
 
-    // This must follow is_sign_key_hash_pattern for ambiguity comment to hold.
-    if (is_sign_script_hash_pattern(operations_))
+    // is_sign_key_hash_pattern
+    if (count == 2 && is_endorsement(0))
+    {
+        const auto begin = bytes.data() + tokens[1].offset;
+
+        if (is_public_key({ begin, begin + tokens[1].size }))
+            return script_pattern::sign_key_hash;
+    }
+
+    // is_sign_script_hash_pattern
+    const auto push = [](const token& token)
+    {
+        return operation::is_push(token.code);
+    };
+
+    if (count > 0 && std::all_of(tokens.begin(), tokens.end(), push) &&
+        tokens.back().size != 0)
         return script_pattern::sign_script_hash;
 
-    if (is_sign_public_key_pattern(operations_))
+    // is_sign_public_key_pattern
+    if (count == 1 && is_endorsement(0))
         return script_pattern::sign_public_key;
 
-    if (is_sign_multisig_pattern(operations_))
-        return script_pattern::sign_multisig;
+    // is_sign_multisig_pattern
+    if (count < 2 || tokens[0].code != opcode::push_size_0)
+        return script_pattern::non_standard;
+
+    for (size_t index = 1; index < count; ++index)
+        if (!is_endorsement(index))
+            return script_pattern::non_standard;
 
-    return script_pattern::non_standard;
+    return script_pattern::sign_multisig;
+}
+
+// private/static
+script_version script::classify_version(const token::list& tokens)
+{
+    // is_witness_program_pattern
+    if (tokens.size() != 2 || !operation::is_version(tokens[0].code) ||
+        tokens[1].size < min_witness_program ||
+        tokens[1].size > max_witness_program)
+        return script_version::unversioned;
+
+    // Version 0 is specified, others are reserved (bip141).
+    return tokens[0].code == opcode::push_size_0 ? script_version::zero :
+        script_version::reserved;
 }
 
 bool script::is_pay_to_witness(uint32_t forks) const
 {
-    const auto this_id = boost::this_thread::get_id();
     // This is used internally as an optimization over using script::pattern.
-    // The first operations access must be method-based to guarantee the cache.
-    bool bien = is_enabled(forks, rule_fork::bip141_rule);
-    if (bien)
-    {
-        LOG_VERBOSE(LOG_SYSTEM)
-        << this_id
-        << " script::is_pay_to_witness bien";
-    }
-    else
-    {
-        LOG_VERBOSE(LOG_SYSTEM)
-        << this_id
-        << " script::is_pay_to_witness mal";
-    }
-    auto bops = operations();
-    bool biwi = is_witness_program_pattern(bops);
-    if (biwi)
-    {
-        LOG_VERBOSE(LOG_SYSTEM)
-        << this_id
-        << " script::is_pay_to_witness biwi";
-    }
-    else
-    {
-        LOG_VERBOSE(LOG_SYSTEM)
-        << this_id
-        << " script::is_pay_to_witness biwi is false";
-    }
-    return bien && biwi;
+    // The witness program pattern is classified and cached with the tokens.
+    return is_enabled(forks, rule_fork::bip141_rule) &&
+        version() != script_version::unversioned;
 }
 
 bool script::is_pay_to_script_hash(uint32_t forks) const
@@ -1300,15 +1691,15 @@ inline size_t multisig_sigops(bool accurate, opcode code)
         operation::opcode_to_positive(code) : multisig_default_sigops;
 }
 
-size_t script::sigops(bool accurate) const
+// private/static
+size_t script::count_sigops(const token::list& tokens, bool accurate)
 {
     size_t total = 0;
     auto preceding = opcode::push_negative_1;
 
-    // The first operations access must be method-based to guarantee the cache.
-    for (const auto& op: operations())
+    for (const auto& token: tokens)
     {
-        const auto code = op.code();
+        const auto code = token.code;
 
         if (code == opcode::checksig ||
             code == opcode::checksigverify)
@@ -1328,56 +1719,80 @@ size_t script::sigops(bool accurate) const
     return total;
 }
 
+// Both counts are computed and cached when the tokens are parsed.
+size_t script::sigops(bool accurate) const
+{
+    // The first tokens access must be method-based to guarantee the cache.
+    tokens();
+
+    shared_lock lock(mutex_);
+    return accurate ? accurate_sigops_ : legacy_sigops_;
+}
+
 //*****************************************************************************
 // CONSENSUS: this is a pointless, broken, premature optimization attempt.
 // The comparison and erase are not limited to a single operation and so can
 // erase arbitrary upstream data from the script.
 //*****************************************************************************
-void script::find_and_delete_(const data_chunk& endorsement)
+// A matched value is always a whole push operation, so deleting it does not
+// move any operation boundary. Deleting each endorsement in turn is therefore
+// equivalent to deleting every matching operation in one compacting pass.
+// Concurrent read/write is not supported, so no critical section.
+void script::find_and_delete(const data_stack& endorsements)
 {
-    // If this is empty it would produce an empty script but not operation.
-    // So we test it for empty prior to operation reserialization.
-    if (endorsement.empty())
-        return;
+    data_stack values;
+    values.reserve(endorsements.size());
 
     // The value must be serialized to script using non-minimal encoding.
     // Non-minimally-encoded target values will therefore not match.
-    const auto value = operation(endorsement, false).to_data();
+    // If empty it would produce an empty script but not operation, so skip.
+    for (const auto& endorsement: endorsements)
+        if (!endorsement.empty())
+            values.push_back(operation(endorsement, false).to_data());
 
-    operation op;
-    data_source stream(bytes_);
-    istream_reader source(stream);
-    std::vector<data_chunk::iterator> found;
+    const auto matches = [&values](data_chunk::const_iterator begin,
+        size_t size)
+    {
+        for (const auto& value: values)
+            if (value.size() == size &&
+                std::equal(value.begin(), value.end(), begin))
+                return true;
+
+        return false;
+    };
 
-    // The exhaustion test handles stream end and op deserialization failure.
-    for (auto it = bytes_.begin(); !source.is_exhausted();
-        it += source ? op.serialized_size() : 0)
+    auto to = bytes_.begin();
+    auto from = bytes_.begin();
+
+    // Parsing stops at an invalid token, trailing bytes are retained.
+    for (const auto& token: tokens())
     {
-        // Track all found values for later deletion.
-        for (; starts_with(it, bytes_.end(), value); it += value.size())
-        {
-            source.skip(value.size());
-            found.push_back(it);
-        }
+        if (!token.valid)
+            break;
 
-        // Read the next op code following last found value.
-        op.from_data(source);
+        const auto end = bytes_.begin() + token.offset + token.size;
+        const auto size = static_cast<size_t>(std::distance(from, end));
+
+        if (!matches(from, size))
+            to = (to == from) ? end : std::copy(from, end, to);
+
+        from = end;
     }
 
-    // Delete any found values, reversed to prevent iterator inmetadata.
-    for (const auto it: reverse(found))
-        bytes_.erase(it, it + value.size());
-}
+    // Retain the parse cache if nothing was deleted.
+    if (to == from)
+        return;
 
-// Concurrent read/write is not supported, so no critical section.
-void script::find_and_delete(const data_stack& endorsements)
-{
-    for (const auto& endorsement: endorsements)
-        find_and_delete_(endorsement);
+    bytes_.erase(std::copy(from, bytes_.end(), to), bytes_.end());
 
     // Invalidate the cache so that the operations may be regenerated.
     operations_.clear();
     cached_ = false;
+    tokens_.clear();
+    tokenized_ = false;
+    branches_.clear();
+    legacy_sigops_ = 0;
+    accurate_sigops_ = 0;
     bytes_.shrink_to_fit();
 }
 
@@ -1400,9 +1815,265 @@ void script::find_and_delete(const data_stack& endorsements)
 // The criteria below are not be comprehensive but are fast to evaluate.
 bool script::is_unspendable() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    return (!operations().empty() && operations_[0].code() == opcode::return_)
-        || serialized_size(false) > max_script_size;
+    // The first op code is the first byte, so the script is not parsed.
+    return (!bytes_.empty() &&
+        bytes_.front() == static_cast<uint8_t>(opcode::return_)) ||
+        serialized_size(false) > max_script_size;
+}
+
+// Validation (standard templates).
+//-----------------------------------------------------------------------------
+// These produce success only where evaluation would also succeed. Any other
+// outcome, including an invalid signature, defers to evaluation so that error
+// codes are always those of the interpreter.
+
+// Mirrors interpreter stack_to_bool, for the embedded witness program push.
+static bool is_true(const data_chunk& data)
+{
+    for (auto it = data.begin(); it != data.end(); ++it)
+        if (*it != 0)
+            return !(it == data.end() - 1 && *it == number::negative_0);
+
+    return false;
+}
+
+// Mirrors interpreter op_check_sig_verify, excluding find_and_delete.
+static bool check_endorsement(data_slice endorsement, data_slice public_key,
+    const script& script_code, const transaction& tx, uint32_t input_index,
+    uint32_t forks, script_version version, uint64_t value)
+{
+    // BIP62: An empty endorsement is not considered lax encoding.
+    if (endorsement.empty())
+        return false;
+
+    ec_signature signature;
+    const auto end = endorsement.end() - 1;
+    const auto sighash = *end;
+    const auto bip66 = script::is_enabled(forks, rule_fork::bip66_rule);
+
+    return parse_signature(signature, { endorsement.begin(), end }, bip66) &&
+        script::check_signature(signature, sighash, public_key, script_code,
+            tx, input_index, version, value);
+}
+
+// [endorsement] [public key] : dup hash160 [hash] equalverify checksig
+static bool verify_pay_key_hash(const transaction& tx, uint32_t input_index,
+    uint32_t forks, const script& prevout_script, uint64_t value)
+{
+    const auto& in = tx.inputs()[input_index];
+    const auto& input_script = in.script();
+
+    if (!in.witness().empty() || !input_script.is_valid_operations() ||
+        !script::is_sign_key_hash_pattern(input_script.operations()))
+        return false;
+
+    const auto& ops = input_script.operations();
+    const auto& endorsement = ops[0].data();
+    const auto& public_key = ops[1].data();
+    const auto& hash = prevout_script.operations()[2].data();
+
+    // Find and delete could only match an endorsement the size of the hash.
+    if (endorsement.size() == short_hash_size)
+        return false;
+
+    const auto key_hash = bitcoin_short_hash(public_key);
+
+    // The script code is the full prevout script (no code separator).
+    return std::equal(key_hash.begin(), key_hash.end(), hash.begin()) &&
+        check_endorsement(endorsement, public_key, prevout_script, tx,
+            input_index, forks, script_version::unversioned, value);
+}
+
+// witness: [endorsement] [public key] : program: 0 [hash]
+static bool verify_witness_key_hash(const transaction& tx,
+    uint32_t input_index, uint32_t forks, const data_chunk& program,
+    uint64_t value)
+{
+    const auto& stack = tx.inputs()[input_index].witness();
+
+    // Elements must be within push size limit (bip141).
+    if (stack.size() != 2 || !stack.is_push_size(stack.size()))
+        return false;
+
+    const auto endorsement = stack[0];
+    const auto public_key = stack[1];
+    const auto key_hash = bitcoin_short_hash(public_key);
+
+    if (!std::equal(key_hash.begin(), key_hash.end(), program.begin()))
+        return false;
+
+    // The hash160 of public key must match the program (bip141).
+    short_hash hash;
+    std::copy(program.begin(), program.end(), hash.begin());
+    const script script_code(script::to_pay_key_hash_pattern(hash));
+
+    return check_endorsement(endorsement, public_key, script_code, tx,
+        input_index, forks, script_version::zero, value);
+}
+
+// witness: 0 [endorsement]... [script] : program: 0 [hash]
+// script: [m] [public key]... [n] checkmultisig
+static bool verify_witness_multisig(const transaction& tx,
+    uint32_t input_index, uint32_t forks, const data_chunk& program,
+    uint64_t value)
+{
+    const auto& stack = tx.inputs()[input_index].witness();
+
+    if (stack.size() < 2)
+        return false;
+
+    // SHA256 of the witness script must match program (bip141).
+    const auto encoded = stack.back();
+    const auto script_hash = sha256_hash(encoded);
+
+    if (!std::equal(script_hash.begin(), script_hash.end(), program.begin()))
+        return false;
+
+    const script script_code(to_chunk(encoded), false);
+    const auto& ops = script_code.operations();
+
+    if (!script_code.is_valid_operations() ||
+        !script::is_pay_multisig_pattern(ops))
+        return false;
+
+    const auto required = operation::opcode_to_positive(ops.front().code());
+    const auto keys = ops.size() - 3u;
+
+    // A clean stack requires exactly the dummy and required endorsements.
+    // BIP147: the dummy must be empty (required here regardless of fork).
+    if (stack.size() != required + 2u || !stack.front().empty() ||
+        !stack.is_push_size(stack.size() - 1))
+        return false;
+
+    typedef std::vector<std::pair<uint8_t, hash_digest>> signature_hashes;
+
+    signature_hashes hashes;
+    hashes.reserve(required);
+    std::vector<std::pair<ec_signature, size_t>> signatures;
+    signatures.reserve(required);
+    const auto bip66 = script::is_enabled(forks, rule_fork::bip66_rule);
+
+    // Each endorsement is parsed once, in evaluation order, before any key
+    // is tried (mirrors interpreter op_check_multisig_verify).
+    for (auto index = required; index > 0; --index)
+    {
+        const auto endorsement = stack[index];
+
+        // BIP62: An empty endorsement is not considered lax encoding.
+        if (endorsement.empty())
+            return false;
+
+        ec_signature signature;
+        const auto end = endorsement.end() - 1;
+        const auto sighash_type = *end;
+
+        if (!parse_signature(signature, { endorsement.begin(), end }, bip66))
+            return false;
+
+        // Each sighash type is hashed at most once.
+        auto position = hashes.size();
+        for (size_t hash = 0; hash < hashes.size(); ++hash)
+            if (hashes[hash].first == sighash_type)
+                position = hash;
+
+        if (position == hashes.size())
+            hashes.emplace_back(sighash_type,
+                script::generate_signature_hash(tx, input_index, script_code,
+                    sighash_type, script_version::zero, value));
+
+        signatures.emplace_back(signature, position);
+    }
+
+    // Evaluation pops each section from the top, so both lists are reversed.
+    auto key = keys;
+    const auto first_key = ops.begin() + 1;
+
+    for (const auto& signature: signatures)
+    {
+        const auto& sighash = hashes[signature.second].second;
+
+        // Mirrors evaluation, the key is not advanced after a match.
+        // An empty public key is not a valid point (check_signature).
+        while (first_key[key - 1].data().empty() ||
+            !verify_signature(first_key[key - 1].data(), sighash,
+                signature.first))
+            if (--key == 0)
+                return false;
+    }
+
+    return true;
+}
+
+// static
+bool script::verify_standard(const transaction& tx, uint32_t input_index,
+    uint32_t forks, const script& prevout_script, uint64_t value)
+{
+    if (input_index >= tx.inputs().size() ||
+        !prevout_script.is_valid_operations())
+        return false;
+
+    const auto& in = tx.inputs()[input_index];
+    const auto& ops = prevout_script.operations();
+
+    if (is_pay_key_hash_pattern(ops))
+        return verify_pay_key_hash(tx, input_index, forks, prevout_script,
+            value);
+
+    // Witness templates are only verified with bip143 signature hashing.
+    if (!is_enabled(forks, rule_fork::bip141_rule) ||
+        !is_enabled(forks, rule_fork::bip143_rule))
+        return false;
+
+    // Native witness program, the input script must be empty (bip141).
+    if (is_witness_program_pattern(ops) && in.script().empty() &&
+        ops[0].code() == opcode::push_size_0)
+    {
+        const auto& program = ops[1].data();
+
+        // This precludes bare witness programs of -0 (undocumented).
+        if (!is_true(program))
+            return false;
+
+        if (program.size() == short_hash_size)
+            return verify_witness_key_hash(tx, input_index, forks, program,
+                value);
+
+        if (program.size() == hash_size)
+            return verify_witness_multisig(tx, input_index, forks, program,
+                value);
+
+        return false;
+    }
+
+    // Embedded witness program, the input script must be a single push.
+    if (is_enabled(forks, rule_fork::bip16_rule) &&
+        is_pay_script_hash_pattern(ops))
+    {
+        const auto& input_script = in.script();
+
+        if (!input_script.is_valid_operations() || input_script.size() != 1)
+            return false;
+
+        const auto& push = input_script.operations().front();
+        const auto& embedded = push.data();
+
+        // The embedded script must be [0] [20 byte program].
+        if (!push.is_relaxed_push() ||
+            embedded.size() != 2u + short_hash_size ||
+            embedded[0] != static_cast<uint8_t>(opcode::push_size_0) ||
+            embedded[1] != static_cast<uint8_t>(opcode::push_size_20))
+            return false;
+
+        const data_chunk program(embedded.begin() + 2, embedded.end());
+        const auto script_hash = bitcoin_short_hash(embedded);
+        const auto& hash = ops[1].data();
+
+        return std::equal(script_hash.begin(), script_hash.end(),
+            hash.begin()) && is_true(program) &&
+            verify_witness_key_hash(tx, input_index, forks, program, value);
+    }
+
+    return false;
 }
 
 // Validation.
@@ -1411,9 +2082,17 @@ bool script::is_unspendable() const
 code script::verify(const transaction& tx, uint32_t input_index,
     uint32_t forks, const script& prevout_script, uint64_t value)
 {
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    // Standard templates are verified without the interpreter when possible.
+    if (verify_standard(tx, input_index, forks, prevout_script, value))
+        return error::success;
+
+    return verify_program(tx, input_index, forks, prevout_script, value);
+}
+
+code script::verify_program(const transaction& tx, uint32_t input_index,
+    uint32_t forks, const script& prevout_script, uint64_t value)
+{
+    LOG_TRACE(LOG_SYSTEM)
     << " script::verify()";
 
     if (input_index >= tx.inputs().size())
@@ -1427,9 +2106,8 @@ code script::verify(const transaction& tx, uint32_t input_index,
     program input(in.script(), tx, input_index, forks);
     if ((ec = input.evaluate()))
     {
-           LOG_VERBOSE(LOG_SYSTEM)
-            << this_id
-            << " script::verify() called input.evaluate() and returned";
+        LOG_TRACE(LOG_SYSTEM)
+        << " script::verify() called input.evaluate() and returned";
         return ec;
     }
 
@@ -1437,9 +2115,8 @@ code script::verify(const transaction& tx, uint32_t input_index,
     program prevout(prevout_script, input);
     if ((ec = prevout.evaluate()))
     {
-           LOG_VERBOSE(LOG_SYSTEM)
-            << this_id
-            << " script::verify() called prevout.evaluate() and returned";
+        LOG_TRACE(LOG_SYSTEM)
+        << " script::verify() called prevout.evaluate() and returned";
         return ec;
     }
 
@@ -1452,15 +2129,13 @@ code script::verify(const transaction& tx, uint32_t input_index,
     // Triggered by output script push of version and witness program (bip141).
     if ((witnessed = prevout_script.is_pay_to_witness(forks)))
     {
-        LOG_VERBOSE(LOG_SYSTEM)
-        << this_id
+        LOG_TRACE(LOG_SYSTEM)
         << " script::verify() called is_pay_to_witness() and got nonzero return value";
 
         // The input script must be empty (bip141).
         if (!in.script().empty())
         {
-            LOG_VERBOSE(LOG_SYSTEM)
-            << this_id
+            LOG_TRACE(LOG_SYSTEM)
             << " script::verify() called in.script().empty() and got zero return value";
 
             return error::dirty_witness;
@@ -1470,16 +2145,14 @@ code script::verify(const transaction& tx, uint32_t input_index,
         if ((ec = in.witness().verify(tx, input_index, forks,
             prevout_script, value)))
         {
-            LOG_VERBOSE(LOG_SYSTEM)
-            << this_id
+            LOG_TRACE(LOG_SYSTEM)
             << " script::verify() called witness::verify() and got nonzero return value";
 
             return ec;
         }
         else
         {
-            LOG_VERBOSE(LOG_SYSTEM)
-            << this_id
+            LOG_TRACE(LOG_SYSTEM)
             << " script::verify() called witness::verify() and got zero return value";
         }
     }
@@ -1487,27 +2160,24 @@ code script::verify(const transaction& tx, uint32_t input_index,
     // p2sh and p2w are mutually exclusive.
     else if (prevout_script.is_pay_to_script_hash(forks))
     {
-        LOG_VERBOSE(LOG_SYSTEM)
-        << this_id
+        LOG_TRACE(LOG_SYSTEM)
         << " script::verify() is_pay_to_script_hash()";
 
         if (!is_relaxed_push(in.script().operations()))
         {
-            LOG_VERBOSE(LOG_SYSTEM)
-            << this_id
+            LOG_TRACE(LOG_SYSTEM)
             << " script::verify() is_relaxed_push()";
 
             return error::invalid_script_embed;
         }
 
         // Embedded script must be at the top of the stack (bip16).
-        script embedded_script(input.pop(), false);
+        script embedded_script(input.pop().to_chunk(), false);
 
         program embedded(embedded_script, std::move(input), true);
         if ((ec = embedded.evaluate()))
         {
-            LOG_VERBOSE(LOG_SYSTEM)
-            << this_id
+            LOG_TRACE(LOG_SYSTEM)
             << " script::verify() embedded.evaluate()";
 
             return ec;
@@ -1516,8 +2186,7 @@ code script::verify(const transaction& tx, uint32_t input_index,
         // This precludes embedded witness programs of -0 (undocumented).
         if (!embedded.stack_result(false))
         {
-            LOG_VERBOSE(LOG_SYSTEM)
-            << this_id
+            LOG_TRACE(LOG_SYSTEM)
             << " script::verify() embedded.stack_result(false)";
 
             return error::stack_false;
@@ -1526,15 +2195,13 @@ code script::verify(const transaction& tx, uint32_t input_index,
         // Triggered by embedded push of version and witness program (bip141).
         if ((witnessed = embedded_script.is_pay_to_witness(forks)))
         {
-            LOG_VERBOSE(LOG_SYSTEM)
-            << this_id
+            LOG_TRACE(LOG_SYSTEM)
             << " script::verify() witnessed embedded_script";
 
             // The input script must be a push of the embedded_script (bip141).
             if (in.script().size() != 1)
             {
-                LOG_VERBOSE(LOG_SYSTEM)
-                << this_id
+                LOG_TRACE(LOG_SYSTEM)
                 << " script::verify() in.script().size() != 1";
 
                 return error::dirty_witness;
@@ -1544,8 +2211,7 @@ code script::verify(const transaction& tx, uint32_t input_index,
             if ((ec = in.witness().verify(tx, input_index, forks,
                 embedded_script, value)))
             {
-                LOG_VERBOSE(LOG_SYSTEM)
-                << this_id
+                LOG_TRACE(LOG_SYSTEM)
                 << " script::verify() in.witness().verify()";
 
                 return ec;
@@ -1556,15 +2222,14 @@ code script::verify(const transaction& tx, uint32_t input_index,
     // Witness must be empty if no bip141 or valid witness program (bip141).
     if (!witnessed && !in.witness().empty())
     {
-        LOG_VERBOSE(LOG_SYSTEM)
-        << this_id
+        LOG_TRACE(LOG_SYSTEM)
         << " script::verify() !witnessed && !in.witness().empty()";
 
         return error::unexpected_witness;
     }
-           LOG_VERBOSE(LOG_SYSTEM)
-            << this_id
-            << " script::verify() finished, returning error::success";
+
+    LOG_TRACE(LOG_SYSTEM)
+    << " script::verify() finished, returning error::success";
 
     return error::success;
 }
@@ -129,11 +129,15 @@ transaction::transaction(transaction&& other)
   : hash_(other.hash_cache()),
     total_input_value_(other.total_input_value_cache()),
     total_output_value_(other.total_output_value_cache()),
+    sigops_(other.sigops_cache()),
+    base_size_(other.base_size_cache()),
+    total_size_(other.total_size_cache()),
     version_(other.version_),
     locktime_(other.locktime_),
     inputs_(std::move(other.inputs_)),
     outputs_(std::move(other.outputs_)),
-    metadata(std::move(other.metadata))
+    metadata(std::move(other.metadata)),
+    revision_(0)
 {
 }
 
@@ -141,11 +145,15 @@ transaction::transaction(const transaction& other)
   : hash_(other.hash_cache()),
     total_input_value_(other.total_input_value_cache()),
     total_output_value_(other.total_output_value_cache()),
+    sigops_(other.sigops_cache()),
+    base_size_(other.base_size_cache()),
+    total_size_(other.total_size_cache()),
     version_(other.version_),
     locktime_(other.locktime_),
     inputs_(other.inputs_),
     outputs_(other.outputs_),
-    metadata(other.metadata)
+    metadata(other.metadata),
+    revision_(0)
 {
 }
 
@@ -155,7 +163,8 @@ transaction::transaction(uint32_t version, uint32_t locktime,
     locktime_(locktime),
     inputs_(std::move(inputs)),
     outputs_(std::move(outputs)),
-    metadata{}
+    metadata{},
+    revision_(0)
 {
 }
 
@@ -165,7 +174,8 @@ transaction::transaction(uint32_t version, uint32_t locktime,
     locktime_(locktime),
     inputs_(inputs),
     outputs_(outputs),
-    metadata{}
+    metadata{},
+    revision_(0)
 {
 }
 
@@ -190,6 +200,27 @@ transaction::optional_value transaction::total_output_value_cache() const
     return total_output_value_;
 }
 
+// Private cache access for copy/move construction.
+transaction::sigops_array transaction::sigops_cache() const
+{
+    shared_lock lock(mutex_);
+    return sigops_;
+}
+
+// Private cache access for copy/move construction.
+transaction::optional_size transaction::base_size_cache() const
+{
+    shared_lock lock(mutex_);
+    return base_size_;
+}
+
+// Private cache access for copy/move construction.
+transaction::optional_size transaction::total_size_cache() const
+{
+    shared_lock lock(mutex_);
+    return total_size_;
+}
+
 // Operators.
 //-----------------------------------------------------------------------------
 
@@ -198,11 +229,15 @@ transaction& transaction::operator=(transaction&& other)
     hash_ = other.hash_cache();
     total_input_value_ = other.total_input_value_cache();
     total_output_value_ = other.total_output_value_cache();
+    sigops_ = other.sigops_cache();
+    base_size_ = other.base_size_cache();
+    total_size_ = other.total_size_cache();
     version_ = other.version_;
     locktime_ = other.locktime_;
     inputs_ = std::move(other.inputs_);
     outputs_ = std::move(other.outputs_);
     metadata = std::move(other.metadata);
+    ++revision_;
     return *this;
 }
 
@@ -212,11 +247,15 @@ transaction& transaction::operator=(const transaction& other)
     hash_ = other.hash_cache();
     total_input_value_ = other.total_input_value_cache();
     total_output_value_ = other.total_output_value_cache();
+    sigops_ = other.sigops_cache();
+    base_size_ = other.base_size_cache();
+    total_size_ = other.total_size_cache();
     version_ = other.version_;
     locktime_ = other.locktime_;
     inputs_ = other.inputs_;
     outputs_ = other.outputs_;
     metadata = other.metadata;
+    ++revision_;
     return *this;
 }
 
@@ -346,6 +385,13 @@ bool transaction::from_data(reader& source, bool wire, bool witness)
     if (!source)
         reset();
 
+    // Capture the wire sizes while the tx is hot, for size and weight limits.
+    if (source && wire)
+    {
+        serialized_size(true, false);
+        serialized_size(true, true);
+    }
+
     return source;
 }
 
@@ -385,6 +431,9 @@ void transaction::reset()
     segregated_ = boost::none;
     total_input_value_ = boost::none;
     total_output_value_ = boost::none;
+    sigops_.fill(boost::none);
+    base_size_ = boost::none;
+    total_size_ = boost::none;
 }
 
 bool transaction::is_valid() const
@@ -486,6 +535,49 @@ size_t transaction::serialized_size(bool wire, bool witness) const
     // The witness parameter must be set to false for non-segregated txs.
     witness = witness && is_segregated();
 
+    // Only the wire sizes are cached, these are used for size/weight limits.
+    if (!wire)
+        return serialized_size(inputs_, outputs_, version_, locktime_, false,
+            witness);
+
+    size_t value;
+    auto& cache = witness ? total_size_ : base_size_;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    mutex_.lock_upgrade();
+
+    if (cache != boost::none)
+    {
+        value = cache.get();
+        mutex_.unlock_upgrade();
+        //---------------------------------------------------------------------
+        return value;
+    }
+
+    mutex_.unlock_upgrade_and_lock();
+    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+    value = serialized_size(inputs_, outputs_, version_, locktime_, true,
+        witness);
+
+    // The base size is also the total size of a non-segregated tx.
+    if (!witness)
+        base_size_ = value;
+    else
+        total_size_ = value;
+
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    return value;
+}
+
+// private/static
+size_t transaction::serialized_size(const input::list& inputs,
+    const output::list& outputs, uint32_t version, uint32_t locktime,
+    bool wire, bool witness)
+{
     // Returns space for the witness although not serialized by input.
     // Returns witness space if specified even if input not segregated.
     const auto ins = [wire, witness](size_t size, const input& input)
@@ -501,12 +593,12 @@ size_t transaction::serialized_size(bool wire, bool witness) const
     // Must be both witness and wire encoding for bip144 serialization.
     return (wire && witness ? sizeof(witness_marker) : 0)
         + (wire && witness ? sizeof(witness_flag) : 0)
-        + (wire ? sizeof(version_) : message::variable_uint_size(version_))
-        + (wire ? sizeof(locktime_) : message::variable_uint_size(locktime_))
-        + message::variable_uint_size(inputs_.size())
-        + message::variable_uint_size(outputs_.size())
-        + std::accumulate(inputs_.begin(), inputs_.end(), size_t{0}, ins)
-        + std::accumulate(outputs_.begin(), outputs_.end(), size_t{0}, outs);
+        + (wire ? sizeof(version) : message::variable_uint_size(version))
+        + (wire ? sizeof(locktime) : message::variable_uint_size(locktime))
+        + message::variable_uint_size(inputs.size())
+        + message::variable_uint_size(outputs.size())
+        + std::accumulate(inputs.begin(), inputs.end(), size_t{0}, ins)
+        + std::accumulate(outputs.begin(), outputs.end(), size_t{0}, outs);
 }
 
 // Accessors.
@@ -536,6 +628,15 @@ void transaction::set_locktime(uint32_t value)
 
 input::list& transaction::inputs()
 {
+    // The inputs may be modified through the reference.
+    invalidate_cache();
+    inpoints_hash_.reset();
+    sequences_hash_.reset();
+    segregated_ = boost::none;
+    total_input_value_ = boost::none;
+    sigops_.fill(boost::none);
+    base_size_ = boost::none;
+    total_size_ = boost::none;
     return inputs_;
 }
 
@@ -552,6 +653,9 @@ void transaction::set_inputs(const input::list& value)
     sequences_hash_.reset();
     segregated_ = boost::none;
     total_input_value_ = boost::none;
+    sigops_.fill(boost::none);
+    base_size_ = boost::none;
+    total_size_ = boost::none;
 }
 
 void transaction::set_inputs(input::list&& value)
@@ -560,10 +664,20 @@ void transaction::set_inputs(input::list&& value)
     invalidate_cache();
     segregated_ = boost::none;
     total_input_value_ = boost::none;
+    sigops_.fill(boost::none);
+    base_size_ = boost::none;
+    total_size_ = boost::none;
 }
 
 output::list& transaction::outputs()
 {
+    // The outputs may be modified through the reference.
+    invalidate_cache();
+    outputs_hash_.reset();
+    total_output_value_ = boost::none;
+    sigops_.fill(boost::none);
+    base_size_ = boost::none;
+    total_size_ = boost::none;
     return outputs_;
 }
 
@@ -578,6 +692,9 @@ void transaction::set_outputs(const output::list& value)
     invalidate_cache();
     outputs_hash_.reset();
     total_output_value_ = boost::none;
+    sigops_.fill(boost::none);
+    base_size_ = boost::none;
+    total_size_ = boost::none;
 }
 
 void transaction::set_outputs(output::list&& value)
@@ -585,6 +702,9 @@ void transaction::set_outputs(output::list&& value)
     outputs_ = std::move(value);
     invalidate_cache();
     total_output_value_ = boost::none;
+    sigops_.fill(boost::none);
+    base_size_ = boost::none;
+    total_size_ = boost::none;
 }
 
 // Cache.
@@ -593,6 +713,8 @@ void transaction::set_outputs(output::list&& value)
 // protected
 void transaction::invalidate_cache() const
 {
+    ++revision_;
+
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
     hash_mutex_.lock_upgrade();
@@ -611,6 +733,12 @@ void transaction::invalidate_cache() const
     ///////////////////////////////////////////////////////////////////////////
 }
 
+// protected
+uint32_t transaction::revision() const
+{
+    return revision_;
+}
+
 hash_digest transaction::hash(bool witness) const
 {
     // Witness hashing must be disabled for non-segregated txs.
@@ -734,11 +862,15 @@ void transaction::strip_witness()
         input.strip_witness();
     };
 
+    // The witness encoding changes, along with any encoding derived from it.
+    invalidate_cache();
+
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
     unique_lock lock(mutex_);
 
     segregated_ = false;
+    total_size_ = boost::none;
     std::for_each(inputs_.begin(), inputs_.end(), strip);
     ///////////////////////////////////////////////////////////////////////////
 }
@@ -904,14 +1036,46 @@ bool transaction::is_overspent()
 size_t transaction::signature_operations()
 {
     const auto state = metadata.state;
+
+    if (!state)
+        return max_size_t;
+
     const auto bip16 = state->is_enabled(rule_fork::bip16_rule);
     const auto bip141 = state->is_enabled(rule_fork::bip141_rule);
-    return state ? signature_operations(bip16, bip141) : max_size_t;
+    return signature_operations(bip16, bip141);
+}
+
+// The cache is keyed on the fork combination that affects the count.
+inline size_t sigops_key(bool bip16, bool bip141)
+{
+    return (bip16 ? 1u : 0u) | (bip141 ? 2u : 0u);
 }
 
 // Returns max_size_t in case of overflow.
+// Counts under bip16/bip141 depend on prevouts, so these are cached only once
+// all prevouts are populated. The legacy count is always cached.
 size_t transaction::signature_operations(bool bip16, bool bip141)
 {
+    size_t value;
+    auto& cache = sigops_[sigops_key(bip16, bip141)];
+    const auto cacheable = !(bip16 || bip141) ||
+        !is_missing_previous_outputs();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    mutex_.lock_upgrade();
+
+    if (cache != boost::none)
+    {
+        value = cache.get();
+        mutex_.unlock_upgrade();
+        //---------------------------------------------------------------------
+        return value;
+    }
+
+    mutex_.unlock_upgrade_and_lock();
+    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
      auto in = [bip16, bip141](size_t total,  input& input)
     {
         // This includes BIP16 p2sh additional sigops if prevout is cached.
@@ -923,8 +1087,17 @@ size_t transaction::signature_operations(bool bip16, bool bip141)
         return ceiling_add(total, output.signature_operations(bip141));
     };
 
-    return std::accumulate(inputs_.begin(), inputs_.end(), size_t{0}, in) +
-        std::accumulate(outputs_.begin(), outputs_.end(), size_t{0}, out);
+    value = ceiling_add(
+        std::accumulate(inputs_.begin(), inputs_.end(), size_t{0}, in),
+        std::accumulate(outputs_.begin(), outputs_.end(), size_t{0}, out));
+
+    if (cacheable)
+        cache = value;
+
+    mutex_.unlock();
+    ///////////////////////////////////////////////////////////////////////////
+
+    return value;
 }
 
 size_t transaction::weight() const
@@ -1124,10 +1297,9 @@ code transaction::check(uint64_t max_money, bool transaction_pool)
     // This will not make a difference unless prevouts are populated, in which
     // case they are ignored. This means that p2sh sigops are not counted here.
     // This is a preliminary check, the final count must come from accept().
-    // Reenable once sigop caching is implemented, otherwise is deoptimization.
-    ////else if (transaction_pool &&
-    ////    signature_operations(false, false) > max_block_sigops)
-    ////    return error::transaction_legacy_sigop_limit;
+    else if (transaction_pool &&
+        signature_operations(false, false) > max_block_sigops)
+        return error::transaction_legacy_sigop_limit;
 
     else
         return error::success;
@@ -1190,7 +1362,6 @@ code transaction::accept(const chain_state& state, bool transaction_pool)
     else if (transaction_pool && signature_operations(bip16, bip141) > max_sigops)
         return error::transaction_embedded_sigop_limit;
 
-    // This causes second serialized_size(true, false) computation (uncached).
     // TODO: reduce by header, txcount and smallest coinbase size for height.
     else if (transaction_pool && bip141 && weight() > max_block_weight)
         return error::transaction_weight_limit;
@@ -0,0 +1,436 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/transaction_view.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <bitcoin/bitcoin/chain/input.hpp>
+#include <bitcoin/bitcoin/chain/output.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/chain/witness.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+static BC_CONSTEXPR size_t version_size = sizeof(uint32_t);
+static BC_CONSTEXPR size_t locktime_size = sizeof(uint32_t);
+static BC_CONSTEXPR size_t value_size = sizeof(uint64_t);
+static BC_CONSTEXPR size_t sequence_size = sizeof(uint32_t);
+static BC_CONSTEXPR size_t point_size = hash_size + sizeof(uint32_t);
+static BC_CONSTEXPR size_t marker_size = sizeof(witness_marker) +
+    sizeof(witness_flag);
+
+// Bounds-checked forward walk over the wire encoding (no allocation).
+class view_walker
+{
+public:
+    view_walker(const uint8_t* begin, const uint8_t* end)
+      : it_(begin), end_(end), valid_(true)
+    {
+    }
+
+    operator bool() const
+    {
+        return valid_;
+    }
+
+    const uint8_t* position() const
+    {
+        return it_;
+    }
+
+    uint8_t peek(size_t offset) const
+    {
+        return valid_ && offset < remaining() ? it_[offset] : 0;
+    }
+
+    void skip(uint64_t size)
+    {
+        if (!valid_ || size > remaining())
+            invalidate();
+        else
+            it_ += size;
+    }
+
+    // Returns zero and invalidates if the count exceeds the limit.
+    size_t read_size(size_t limit)
+    {
+        uint64_t value = 0;
+        const auto prefix = peek(0);
+        skip(1);
+
+        switch (prefix)
+        {
+            case varint_eight_bytes:
+                value = read_little_endian(sizeof(uint64_t));
+                break;
+            case varint_four_bytes:
+                value = read_little_endian(sizeof(uint32_t));
+                break;
+            case varint_two_bytes:
+                value = read_little_endian(sizeof(uint16_t));
+                break;
+            default:
+                value = prefix;
+                break;
+        }
+
+        if (value > limit)
+            invalidate();
+
+        return valid_ ? static_cast<size_t>(value) : 0;
+    }
+
+private:
+    size_t remaining() const
+    {
+        return static_cast<size_t>(end_ - it_);
+    }
+
+    void invalidate()
+    {
+        valid_ = false;
+        it_ = end_;
+    }
+
+    uint64_t read_little_endian(size_t size)
+    {
+        uint64_t value = 0;
+
+        if (size > remaining())
+        {
+            invalidate();
+            return value;
+        }
+
+        for (size_t byte = 0; byte < size; ++byte)
+            value |= static_cast<uint64_t>(it_[byte]) << (8 * byte);
+
+        it_ += size;
+        return value;
+    }
+
+    const uint8_t* it_;
+    const uint8_t* const end_;
+    bool valid_;
+};
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+transaction_view::transaction_view()
+  : begin_(nullptr), size_(0)
+{
+}
+
+transaction_view::transaction_view(transaction_view&& other)
+  : begin_(other.begin_),
+    size_(other.size_),
+    inputs_(std::move(other.inputs_)),
+    outputs_(std::move(other.outputs_)),
+    witnesses_(std::move(other.witnesses_))
+{
+}
+
+transaction_view::transaction_view(const transaction_view& other)
+  : begin_(other.begin_),
+    size_(other.size_),
+    inputs_(other.inputs_),
+    outputs_(other.outputs_),
+    witnesses_(other.witnesses_)
+{
+}
+
+transaction_view::transaction_view(data_slice data)
+  : transaction_view()
+{
+    from_data(data);
+}
+
+// Operators.
+//-----------------------------------------------------------------------------
+
+transaction_view& transaction_view::operator=(transaction_view&& other)
+{
+    begin_ = other.begin_;
+    size_ = other.size_;
+    inputs_ = std::move(other.inputs_);
+    outputs_ = std::move(other.outputs_);
+    witnesses_ = std::move(other.witnesses_);
+    return *this;
+}
+
+transaction_view& transaction_view::operator=(const transaction_view& other)
+{
+    begin_ = other.begin_;
+    size_ = other.size_;
+    inputs_ = other.inputs_;
+    outputs_ = other.outputs_;
+    witnesses_ = other.witnesses_;
+    return *this;
+}
+
+// Deserialization.
+//-----------------------------------------------------------------------------
+
+bool transaction_view::from_data(data_slice data)
+{
+    reset();
+    const auto begin = data.begin();
+    const auto size = parse(begin, data.end(), &inputs_, &outputs_,
+        &witnesses_);
+
+    if (size == 0)
+    {
+        reset();
+        return false;
+    }
+
+    begin_ = begin;
+    size_ = size;
+    return true;
+}
+
+// static
+size_t transaction_view::measure(data_slice data)
+{
+    return parse(data.begin(), data.end(), nullptr, nullptr, nullptr);
+}
+
+// private/static
+// Offsets are relative to begin, each list is terminated by its end offset.
+size_t transaction_view::parse(const uint8_t* begin, const uint8_t* end,
+    offsets* inputs, offsets* outputs, offsets* witnesses)
+{
+    view_walker source(begin, end);
+    const auto offset = [&]()
+    {
+        return static_cast<size_t>(source.position() - begin);
+    };
+
+    source.skip(version_size);
+
+    // Detect witness as no inputs (marker) and expected flag (bip144).
+    const auto segregated = source.peek(0) == witness_marker &&
+        source.peek(1) == witness_flag;
+
+    if (segregated)
+        source.skip(marker_size);
+
+    // Guard against potential for arbitary memory allocation.
+    const auto input_count = source.read_size(max_block_size);
+
+    if (inputs != nullptr && source)
+        inputs->reserve(input_count + 1);
+
+    for (size_t input = 0; input < input_count && source; ++input)
+    {
+        if (inputs != nullptr)
+            inputs->push_back(offset());
+
+        source.skip(point_size);
+        source.skip(source.read_size(max_block_size));
+        source.skip(sequence_size);
+    }
+
+    if (inputs != nullptr)
+        inputs->push_back(offset());
+
+    const auto output_count = source.read_size(max_block_size);
+
+    if (outputs != nullptr && source)
+        outputs->reserve(output_count + 1);
+
+    for (size_t output = 0; output < output_count && source; ++output)
+    {
+        if (outputs != nullptr)
+            outputs->push_back(offset());
+
+        source.skip(value_size);
+        source.skip(source.read_size(max_block_size));
+    }
+
+    if (outputs != nullptr)
+        outputs->push_back(offset());
+
+    // Witness count is not written as it is inferred from input count.
+    if (segregated)
+    {
+        if (witnesses != nullptr)
+            witnesses->reserve(input_count + 1);
+
+        for (size_t input = 0; input < input_count && source; ++input)
+        {
+            if (witnesses != nullptr)
+                witnesses->push_back(offset());
+
+            const auto count = source.read_size(max_block_weight);
+
+            for (size_t element = 0; element < count && source; ++element)
+                source.skip(source.read_size(max_block_weight));
+        }
+
+        if (witnesses != nullptr)
+            witnesses->push_back(offset());
+    }
+
+    source.skip(locktime_size);
+    return source ? offset() : 0;
+}
+
+// protected
+void transaction_view::reset()
+{
+    begin_ = nullptr;
+    size_ = 0;
+    inputs_.clear();
+    outputs_.clear();
+    witnesses_.clear();
+}
+
+bool transaction_view::is_valid() const
+{
+    return begin_ != nullptr;
+}
+
+// Properties (size, accessors).
+//-----------------------------------------------------------------------------
+
+data_slice transaction_view::data() const
+{
+    return { begin_, begin_ + size_ };
+}
+
+size_t transaction_view::serialized_size(bool witness) const
+{
+    if (witness || !is_segregated())
+        return size_;
+
+    return size_ - marker_size - (witnesses_.back() - witnesses_.front());
+}
+
+bool transaction_view::is_segregated() const
+{
+    return !witnesses_.empty();
+}
+
+uint32_t transaction_view::version() const
+{
+    return is_valid() ? from_little_endian_unsafe<uint32_t>(begin_) : 0;
+}
+
+uint32_t transaction_view::locktime() const
+{
+    return is_valid() ? from_little_endian_unsafe<uint32_t>(begin_ + size_ -
+        locktime_size) : 0;
+}
+
+size_t transaction_view::inputs_size() const
+{
+    return inputs_.empty() ? 0 : inputs_.size() - 1;
+}
+
+size_t transaction_view::outputs_size() const
+{
+    return outputs_.empty() ? 0 : outputs_.size() - 1;
+}
+
+data_slice transaction_view::input_data(size_t index) const
+{
+    BITCOIN_ASSERT(index < inputs_size());
+    return { begin_ + inputs_[index], begin_ + inputs_[index + 1] };
+}
+
+data_slice transaction_view::output_data(size_t index) const
+{
+    BITCOIN_ASSERT(index < outputs_size());
+    return { begin_ + outputs_[index], begin_ + outputs_[index + 1] };
+}
+
+uint64_t transaction_view::output_value(size_t index) const
+{
+    BITCOIN_ASSERT(index < outputs_size());
+    return from_little_endian_unsafe<uint64_t>(begin_ + outputs_[index]);
+}
+
+// The script prefix was validated when indexed.
+data_slice transaction_view::output_script(size_t index) const
+{
+    const auto data = output_data(index);
+    view_walker source(data.begin() + value_size, data.end());
+    const auto size = source.read_size(max_block_size);
+    return { source.position(), source.position() + size };
+}
+
+chain::input transaction_view::input(size_t index) const
+{
+    const auto data = input_data(index);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    auto input = chain::input::factory(source, true);
+
+    if (is_segregated())
+    {
+        const auto begin = begin_ + witnesses_[index];
+        const auto end = begin_ + witnesses_[index + 1];
+        auto witness_source = make_safe_deserializer(begin, end);
+        input.set_witness(witness::factory(witness_source, true));
+    }
+
+    return input;
+}
+
+chain::output transaction_view::output(size_t index) const
+{
+    const auto data = output_data(index);
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return chain::output::factory(source, true);
+}
+
+hash_digest transaction_view::hash(bool witness) const
+{
+    if (witness || !is_segregated())
+        return bitcoin_hash(data());
+
+    // Hash the base encoding around the marker/flag and the witnesses.
+    const auto inputs = begin_ + version_size + marker_size;
+    const auto locktime = begin_ + size_ - locktime_size;
+
+    return bitcoin_hash(
+    {
+        data_slice{ begin_, begin_ + version_size },
+        data_slice{ inputs, begin_ + witnesses_.front() },
+        data_slice{ locktime, locktime + locktime_size }
+    });
+}
+
+transaction transaction_view::to_transaction(bool witness) const
+{
+    const auto data = this->data();
+    auto source = make_safe_deserializer(data.begin(), data.end());
+    return transaction::factory(source, true, witness);
+}
+
+} // namespace chain
+} // namespace libbitcoin
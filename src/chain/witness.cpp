@@ -52,6 +52,10 @@ namespace chain {
 
 using namespace bc::machine;
 
+// The element count is untrusted, so reserve no more than a typical witness
+// up front and let the offsets grow as elements are actually read.
+static BC_CONSTEXPR size_t max_reserved_elements = 16;
+
 // Constructors.
 //-----------------------------------------------------------------------------
 
@@ -62,23 +66,27 @@ witness::witness()
 }
 
 witness::witness(witness&& other)
-  : stack_(std::move(other.stack_)), valid_(other.valid_)
+  : valid_(other.valid_),
+    data_(std::move(other.data_)),
+    offsets_(std::move(other.offsets_))
 {
 }
 
 witness::witness(const witness& other)
-  : stack_(other.stack_), valid_(other.valid_)
+  : valid_(other.valid_), data_(other.data_), offsets_(other.offsets_)
 {
 }
 
 witness::witness(const data_stack& stack)
+  : valid_(true)
 {
-    stack_ = stack;
+    assign(stack);
 }
 
 witness::witness(data_stack&& stack)
+  : valid_(true)
 {
-    stack_ = std::move(stack);
+    assign(stack);
 }
 
 witness::witness(data_chunk&& encoded, bool prefix)
@@ -91,13 +99,36 @@ witness::witness(const data_chunk& encoded, bool prefix)
     from_data(encoded, prefix);
 }
 
+// private
+void witness::assign(const data_stack& stack)
+{
+    const auto sum = [](size_t total, const data_chunk& element)
+    {
+        return total + element.size();
+    };
+
+    data_.reserve(std::accumulate(stack.begin(), stack.end(), size_t(0), sum));
+    offsets_.reserve(stack.size());
+
+    for (const auto& element: stack)
+        push_back(element);
+}
+
+// private
+void witness::push_back(data_slice element)
+{
+    data_.insert(data_.end(), element.begin(), element.end());
+    offsets_.push_back(data_.size());
+}
+
 // Operators.
 //-----------------------------------------------------------------------------
 
 witness& witness::operator=(witness&& other)
 {
     reset();
-    stack_ = std::move(other.stack_);
+    data_ = std::move(other.data_);
+    offsets_ = std::move(other.offsets_);
     valid_ = other.valid_;
     return *this;
 }
@@ -105,13 +136,16 @@ witness& witness::operator=(witness&& other)
 witness& witness::operator=(const witness& other)
 {
     reset();
-    stack_ = other.stack_;
+    data_ = other.data_;
+    offsets_ = other.offsets_;
     valid_ = other.valid_;
     return *this;
 }
+
+// Element boundaries and contents together are equivalent to stack equality.
 bool witness::operator==(const witness& other) const
 {
-    return stack_ == other.stack_;
+    return offsets_ == other.offsets_ && data_ == other.data_;
 }
 
 bool witness::operator!=(const witness& other) const
@@ -164,7 +198,8 @@ bool witness::from_data(reader& source, bool prefix)
     reset();
     valid_ = true;
 
-    const auto read_element = [](reader& source)
+    // Elements are read directly into the witness buffer.
+    const auto read_element = [this](reader& source)
     {
         // Tokens encoded as variable integer prefixed byte array (bip144).
         const auto size = source.read_size_little_endian();
@@ -175,24 +210,34 @@ bool witness::from_data(reader& source, bool prefix)
         if (size > max_block_weight)
         {
             source.invalidate();
-            return data_chunk{};
+            return;
         }
 
-        return source.read_bytes(size);
+        const auto offset = data_.size();
+        data_.resize(offset + size);
+        source.read_bytes(data_.data() + offset, size);
+        offsets_.push_back(data_.size());
     };
 
-    // TODO: optimize store serialization to avoid loop, reading data directly.
     if (prefix)
     {
         // Witness prefix is an element count, not byte length (unlike script).
         // On wire each witness is prefixed with number of elements (bip144).
-        for (auto count = source.read_size_little_endian(); count > 0; --count)
-             stack_.push_back(read_element(source));
+        const auto count = source.read_size_little_endian();
+
+        // Each element requires at least one byte, so bound the count.
+        if (count > max_block_weight)
+            source.invalidate();
+        else
+            offsets_.reserve(std::min(count, max_reserved_elements));
+
+        for (size_t index = 0; index < count && source; ++index)
+            read_element(source);
     }
     else
     {
         while (!source.is_exhausted())
-            stack_.push_back(read_element(source));
+            read_element(source);
     }
 
     if (!source)
@@ -201,25 +246,14 @@ bool witness::from_data(reader& source, bool prefix)
     return source;
 }
 
-// private/static
-size_t witness::serialized_size(const data_stack& stack)
-{
-    const auto sum = [](size_t total, const data_chunk& element)
-    {
-        // Tokens encoded as variable integer prefixed byte array (bip144).
-        const auto size = element.size();
-        return total + message::variable_uint_size(size) + size;
-    };
-
-    return std::accumulate(stack.begin(), stack.end(), size_t(0), sum);
-}
-
 // protected
 void witness::reset()
 {
     valid_ = false;
-    stack_.clear();
-    stack_.shrink_to_fit();
+    data_.clear();
+    data_.shrink_to_fit();
+    offsets_.clear();
+    offsets_.shrink_to_fit();
 }
 
 bool witness::is_valid() const
@@ -253,17 +287,14 @@ void witness::to_data(writer& sink, bool prefix) const
 {
     // Witness prefix is an element count, not byte length (unlike script).
     if (prefix)
-        sink.write_variable_little_endian(stack_.size());
+        sink.write_variable_little_endian(size());
 
-    const auto serialize = [&sink](const data_chunk& element)
+    for (const auto element: *this)
     {
         // Tokens encoded as variable integer prefixed byte array (bip144).
         sink.write_variable_little_endian(element.size());
         sink.write_bytes(element);
-    };
-
-    // TODO: optimize store serialization to avoid loop, writing data directly.
-    std::for_each(stack_.begin(), stack_.end(), serialize);
+    }
 }
 
 std::string witness::to_string() const
@@ -272,12 +303,10 @@ std::string witness::to_string() const
         return "<invalid>";
 
     std::string text;
-    const auto serialize = [&text](const data_chunk& element)
-    {
+
+    for (const auto element: *this)
         text += "[" + encode_base16(element) + "] ";
-    };
 
-    std::for_each(stack_.begin(), stack_.end(), serialize);
     return boost::trim_copy(text);
 }
 
@@ -292,40 +321,75 @@ void witness::clear()
 
 bool witness::empty() const
 {
-    return stack_.empty();
+    return offsets_.empty();
 }
 
 size_t witness::size() const
 {
-    return stack_.size();
+    return offsets_.size();
 }
 
-const data_chunk& witness::front() const
+data_slice witness::front() const
 {
-    BITCOIN_ASSERT(!stack_.empty());
-    return stack_.front();
+    BITCOIN_ASSERT(!offsets_.empty());
+    return (*this)[0];
 }
 
-const data_chunk& witness::back() const
+data_slice witness::back() const
 {
-    BITCOIN_ASSERT(!stack_.empty());
-    return stack_.back();
+    BITCOIN_ASSERT(!offsets_.empty());
+    return (*this)[offsets_.size() - 1];
 }
 
-const data_chunk& witness::operator[](size_t index) const
+data_slice witness::operator[](size_t index) const
 {
-    BITCOIN_ASSERT(index < stack_.size());
-    return stack_[index];
+    BITCOIN_ASSERT(index < offsets_.size());
+    const auto begin = data_.data();
+    const auto offset = index == 0 ? 0 : offsets_[index - 1];
+    return { begin + offset, begin + offsets_[index] };
 }
 
 witness::iterator witness::begin() const
 {
-    return stack_.begin();
+    return { *this, 0 };
 }
 
 witness::iterator witness::end() const
 {
-    return stack_.end();
+    return { *this, offsets_.size() };
+}
+
+witness::iterator::iterator(const witness& owner, size_t index)
+  : owner_(&owner), index_(index)
+{
+}
+
+data_slice witness::iterator::operator*() const
+{
+    return (*owner_)[index_];
+}
+
+witness::iterator& witness::iterator::operator++()
+{
+    ++index_;
+    return *this;
+}
+
+witness::iterator witness::iterator::operator++(int)
+{
+    auto copy = *this;
+    ++index_;
+    return copy;
+}
+
+bool witness::iterator::operator==(const iterator& other) const
+{
+    return owner_ == other.owner_ && index_ == other.index_;
+}
+
+bool witness::iterator::operator!=(const iterator& other) const
+{
+    return !(*this == other);
 }
 
 // Properties (size).
@@ -333,14 +397,25 @@ witness::iterator witness::end() const
 
 size_t witness::serialized_size(bool prefix) const
 {
+    // Tokens encoded as variable integer prefixed byte array (bip144).
+    size_t total = data_.size();
+
+    for (const auto element: *this)
+        total += message::variable_uint_size(element.size());
+
     // Witness prefix is an element count, not a byte length (unlike script).
-    return (prefix ? message::variable_uint_size(stack_.size()) : 0u) +
-        serialized_size(stack_);
+    return (prefix ? message::variable_uint_size(size()) : 0u) + total;
 }
 
-const data_stack& witness::stack() const
+data_stack witness::stack() const
 {
-    return stack_;
+    data_stack out;
+    out.reserve(size());
+
+    for (const auto element: *this)
+        out.emplace_back(element.begin(), element.end());
+
+    return out;
 }
 
 // Utilities.
@@ -365,6 +440,23 @@ bool witness::is_reserved_pattern(const data_stack& stack)
         stack[0].size() == hash_size;
 }
 
+bool witness::is_push_size(size_t count) const
+{
+    BITCOIN_ASSERT(count <= size());
+
+    for (size_t index = 0; index < count; ++index)
+        if ((*this)[index].size() > max_push_data_size)
+            return false;
+
+    return true;
+}
+
+// The (only) coinbase witness must be (arbitrary) 32-byte value (bip141).
+bool witness::is_reserved_pattern() const
+{
+    return size() == 1 && front().size() == hash_size;
+}
+
 // private
 // This is an internal optimization over using script::to_pay_key_hash_pattern.
 operation::list witness::to_pay_key_hash(data_chunk&& program)
@@ -399,8 +491,8 @@ bool witness::extract_sigop_script(script& out_script,
                     return true;
 
                 case hash_size:
-                    if (!stack_.empty())
-                        out_script.from_data(stack_.back(), false);
+                    if (!empty())
+                        out_script.from_data(to_chunk(back()), false);
 
                     return true;
 
@@ -420,9 +512,8 @@ bool witness::extract_sigop_script(script& out_script,
 
 // Extract P2WPKH or P2WSH script as indicated by program script.
 bool witness::extract_embedded_script(script& out_script,
-    data_stack& out_stack, const script& program_script) const
+    stack_element::list& out_stack, const script& program_script) const
 {
-    const auto this_id = boost::this_thread::get_id();
     switch (program_script.version())
     {
         // The v0 program size must be either 20 or 32 bytes (bip141).
@@ -430,7 +521,7 @@ bool witness::extract_embedded_script(script& out_script,
         {
             auto program = program_script.witness_program();
             const auto program_size = program.size();
-            out_stack = stack_;
+            out_stack.clear();
 
             // for tx with only segwit inputs, always: <signature> <pubkey>
             // for tx with a mix of segwit and non-segwit inputs, see:
@@ -438,15 +529,14 @@ bool witness::extract_embedded_script(script& out_script,
             // "By bip141 rules, when a segwit input and a non segwit input are redeemed in the same transaction, the non-segwit input will have an empty witness."
             if (program_size == short_hash_size)
             {
-                if (!is_push_size(out_stack))
+                if (!is_push_size(size()))
                 {
-                    LOG_VERBOSE(LOG_SYSTEM)
-                    << this_id
+                    LOG_TRACE(LOG_SYSTEM)
                     << " witness::extract_embedded_script() !is_push_size";
                     
                     return false;
                 }
-                if (out_stack.size() == 0)
+                if (size() == 0)
                 {
                     // how do we verify that this is in fact a mixed-input transaction?
                     // set flags to indicate the presence of segwit/non-segwit inputs processed
@@ -454,16 +544,14 @@ bool witness::extract_embedded_script(script& out_script,
                     // two new flags are not both true and any zero-length witness block was found.
                     // (probably need a third flag to indicate this condition, a zero-length found.
 
-                    LOG_VERBOSE(LOG_SYSTEM)
-                    << this_id
+                    LOG_TRACE(LOG_SYSTEM)
                     << " witness::extract_embedded_script() out_stack.size == 0";
 
                     return true;
                 }
-                else if (out_stack.size() != 2)
+                else if (size() != 2)
                 {
-                    LOG_VERBOSE(LOG_SYSTEM)
-                    << this_id
+                    LOG_TRACE(LOG_SYSTEM)
                     << " witness::extract_embedded_script() out_stack.size != 2 && != 0";
 
                     // a stack size other than 0 or 2 is an error.
@@ -472,10 +560,14 @@ bool witness::extract_embedded_script(script& out_script,
                 else
                 {
                 // Stack will be 2 elements within push size limit, if only segwit inputs (bip141).
-                        LOG_VERBOSE(LOG_SYSTEM)
-                        << this_id
+                        LOG_TRACE(LOG_SYSTEM)
                         << " witness::extract_embedded_script() out_stack.size == 2";
 
+                    // Elements are copied from the witness buffer (inline).
+                    out_stack.reserve(2);
+                    out_stack.emplace_back(front().begin(), front().end());
+                    out_stack.emplace_back(back().begin(), back().end());
+
                     // The hash160 of public key must match the program (bip141).
                     out_script.from_operations(to_pay_key_hash(std::move(program)));
                     return true;
@@ -489,32 +581,39 @@ bool witness::extract_embedded_script(script& out_script,
                 // can 32-byte stack be empty if tx has a mix of segwit and non-segwit inputs? see:
                 // https://bitcointalk.org/index.php?topic=2052851.0
                 // "By bip141 rules, when a segwit input and a non segwit input are redeemed in the same transaction, the non-segwit input will have an empty witness."
-                if (!out_stack.empty())
+                if (!empty())
                 {
-                    LOG_VERBOSE(LOG_SYSTEM)
-                    << this_id
+                    LOG_TRACE(LOG_SYSTEM)
                     << " witness::extract_embedded_script() out_stack.empty() == FALSE";
 
                     // The script is popped off the initial witness stack (bip141).
-                    out_script.from_data(pop(out_stack), false);
+                    const auto count = size() - 1;
+                    out_script.from_data(to_chunk(back()), false);
 
                     // Stack elements must be within push size limit (bip141).
-                    if (!is_push_size(out_stack))
+                    if (!is_push_size(count))
                     {
-                        LOG_VERBOSE(LOG_SYSTEM)
-                        << this_id
+                        LOG_TRACE(LOG_SYSTEM)
                         << " witness::extract_embedded_script() !is_push_size";
                         return false;
                     }
 
+                    // Elements are copied from the witness buffer (inline).
+                    out_stack.reserve(count);
+
+                    for (size_t index = 0; index < count; ++index)
+                    {
+                        const auto element = (*this)[index];
+                        out_stack.emplace_back(element.begin(), element.end());
+                    }
+
                     // SHA256 of the witness script must match program (bip141).
                     return std::equal(program.begin(), program.end(),
                         sha256_hash(out_script.to_data(false)).begin());
                 }
                 else
                 {
-                    LOG_VERBOSE(LOG_SYSTEM)
-                    << this_id
+                    LOG_TRACE(LOG_SYSTEM)
                     << " witness::extract_embedded_script() out_stack.empty() == TRUE";
 
                     // how do we verify that this is in fact a mixed-input transaction?
@@ -526,8 +625,7 @@ bool witness::extract_embedded_script(script& out_script,
                 }
             }
 
-            LOG_VERBOSE(LOG_SYSTEM)
-            << this_id
+            LOG_TRACE(LOG_SYSTEM)
             << " witness::extract_embedded_script() ending function with return false";
 
             return false;
@@ -560,7 +658,7 @@ code witness::verify(const transaction& tx, uint32_t input_index,
         {
             code ec;
             script script;
-            data_stack stack;
+            program::stack stack;
 
             if (!extract_embedded_script(script, stack, program_script))
                 return error::invalid_witness;
@@ -18,6 +18,10 @@
  */
 #include <bitcoin/bitcoin/machine/interpreter.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <bitcoin/bitcoin/chain/script.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
@@ -26,6 +30,27 @@
 namespace libbitcoin {
 namespace machine {
 
+// Get the matching else/endif and the count of skipped counted ops.
+// False if unmatched or a skipped operation would fail if visited.
+static bool skip(const chain::script::branch::list& branches, size_t from,
+    size_t& to, size_t& counted)
+{
+    const auto before = [](const chain::script::branch& branch, size_t from)
+    {
+        return branch.from < from;
+    };
+
+    const auto it = std::lower_bound(branches.begin(), branches.end(), from,
+        before);
+
+    if (it == branches.end() || it->from != from || !it->skippable)
+        return false;
+
+    to = it->to;
+    counted = it->counted;
+    return true;
+}
+
 code interpreter::run(program& program)
 {
     code ec;
@@ -33,24 +58,48 @@ code interpreter::run(program& program)
     if (!program.is_valid())
         return error::invalid_script;
 
-    for (const auto& op: program)
+    const auto begin = program.begin();
+    const auto end = program.end();
+
+    // Branches are matched once per script and fetched once per run.
+    const chain::script::branch::list* branches = nullptr;
+
+    for (auto op = begin; op != end; ++op)
     {
-        if (op.is_oversized())
+        if (op->is_oversized())
             return error::invalid_push_data_size;
 
-        if (op.is_disabled())
+        if (op->is_disabled())
             return error::op_disabled;
 
-        if (!program.increment_operation_count(op))
+        if (!program.increment_operation_count(*op))
             return error::invalid_operation_count;
 
-        if (program.if_(op))
+        if (program.if_(*op))
         {
             if ((ec = run_op(op, program)))
                 return ec;
 
             if (program.is_stack_overflow())
                 return error::invalid_stack_size;
+
+            // Skip an unexecuted branch to its matching else/endif.
+            if (op->is_conditional() && !program.succeeded())
+            {
+                if (branches == nullptr)
+                    branches = &program.branches();
+
+                size_t to;
+                size_t counted;
+                if (skip(*branches, std::distance(begin, op), to, counted))
+                {
+                    if (!program.increment_operation_count(counted))
+                        return error::invalid_operation_count;
+
+                    // The loop increment advances to the else/endif.
+                    op = begin + to - 1;
+                }
+            }
         }
     }
 
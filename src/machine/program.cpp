@@ -20,6 +20,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <utility>
 #include <bitcoin/bitcoin/chain/script.hpp>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
@@ -94,7 +95,7 @@ program::program(const script& script, const chain::transaction& transaction,
 
 // Condition, alternate, jump and operation_count are not copied.
 program::program(const script& script, const chain::transaction& transaction,
-    uint32_t input_index, uint32_t forks, data_stack&& stack, uint64_t value,
+    uint32_t input_index, uint32_t forks, stack&& stack, uint64_t value,
     script_version version)
   : script_(script),
     transaction_(transaction),
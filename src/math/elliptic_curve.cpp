@@ -308,7 +308,7 @@ bool parse_endorsement(uint8_t& sighash_type, der_signature& der_signature,
     return true;
 }
 
-bool parse_signature(ec_signature& out, const der_signature& der_signature,
+bool parse_signature(ec_signature& out, data_slice der_signature,
     bool strict)
 {
     if (der_signature.empty())
@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/golomb_coding.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/constants.hpp>
+
+namespace libbitcoin {
+
+// Bits are written and read most significant first.
+static BC_CONSTEXPR uint8_t high_bit = 0x80;
+
+// The high 64 bits of the 128 bit product.
+static uint64_t multiply_high(uint64_t left, uint64_t right)
+{
+    const auto left_low = left & max_uint32;
+    const auto left_high = left >> 32;
+    const auto right_low = right & max_uint32;
+    const auto right_high = right >> 32;
+
+    const auto low_low = left_low * right_low;
+    const auto low_high = left_low * right_high;
+    const auto high_low = left_high * right_low;
+    const auto high_high = left_high * right_high;
+
+    const auto carry = (low_low >> 32) + (low_high & max_uint32) +
+        (high_low & max_uint32);
+
+    return high_high + (low_high >> 32) + (high_low >> 32) + (carry >> 32);
+}
+
+// Map the item uniformly into [0, bound) without division.
+static uint64_t hash_to_range(data_slice item, uint64_t bound,
+    const siphash_key& key)
+{
+    return multiply_high(siphash(key, item), bound);
+}
+
+static std::vector<uint64_t> hash_to_range(const std::vector<data_slice>& items,
+    uint64_t bound, const siphash_key& key)
+{
+    std::vector<uint64_t> values;
+    values.reserve(items.size());
+
+    for (const auto& item: items)
+        values.push_back(hash_to_range(item, bound, key));
+
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+static void write_bit(data_chunk& out, size_t& offset, bool bit)
+{
+    if (offset % byte_bits == 0)
+        out.push_back(0x00);
+
+    if (bit)
+        out.back() |= (high_bit >> (offset % byte_bits));
+
+    ++offset;
+}
+
+static void golomb_encode(data_chunk& out, size_t& offset, uint64_t value,
+    uint8_t bits)
+{
+    // The quotient is unary coded, terminated by a zero.
+    for (auto quotient = value >> bits; quotient > 0; --quotient)
+        write_bit(out, offset, true);
+
+    write_bit(out, offset, false);
+
+    for (auto bit = bits; bit > 0; --bit)
+        write_bit(out, offset, ((value >> (bit - 1)) & 1) != 0);
+}
+
+static bool golomb_decode(uint64_t& out, data_slice set, size_t& offset,
+    uint8_t bits)
+{
+    const auto data = set.data();
+    const auto end = set.size() * byte_bits;
+    uint64_t quotient = 0;
+
+    for (;; ++quotient, ++offset)
+    {
+        if (offset >= end)
+            return false;
+
+        if ((data[offset / byte_bits] & (high_bit >> (offset % byte_bits))) == 0)
+            break;
+    }
+
+    ++offset;
+
+    if (offset + bits > end)
+        return false;
+
+    // The remainder is read a byte fragment at a time.
+    uint64_t remainder = 0;
+
+    for (size_t remaining = bits; remaining > 0;)
+    {
+        const auto available = byte_bits - (offset % byte_bits);
+        const auto take = std::min<size_t>(available, remaining);
+        const auto mask = (1u << take) - 1;
+        const auto fragment = (data[offset / byte_bits] >> (available - take)) &
+            mask;
+
+        remainder = (remainder << take) | fragment;
+        offset += take;
+        remaining -= take;
+    }
+
+    out = (quotient << bits) | remainder;
+    return true;
+}
+
+data_chunk golomb_construct(const std::vector<data_slice>& items,
+    uint8_t bits, const siphash_key& key, uint64_t rate)
+{
+    const auto values = hash_to_range(items, items.size() * rate, key);
+
+    data_chunk out;
+    out.reserve((values.size() * (bits + 2) + byte_bits - 1) / byte_bits);
+    size_t offset = 0;
+    uint64_t previous = 0;
+
+    for (const auto value: values)
+    {
+        golomb_encode(out, offset, value - previous, bits);
+        previous = value;
+    }
+
+    return out;
+}
+
+bool golomb_match(data_slice target, data_slice set, uint64_t count,
+    uint8_t bits, const siphash_key& key, uint64_t rate)
+{
+    const auto expected = hash_to_range(target, count * rate, key);
+    size_t offset = 0;
+    uint64_t value = 0;
+
+    for (uint64_t index = 0; index < count; ++index)
+    {
+        uint64_t delta;
+        if (!golomb_decode(delta, set, offset, bits))
+            return false;
+
+        value += delta;
+
+        if (value >= expected)
+            return value == expected;
+    }
+
+    return false;
+}
+
+bool golomb_match(const std::vector<data_slice>& targets, data_slice set,
+    uint64_t count, uint8_t bits, const siphash_key& key, uint64_t rate)
+{
+    if (targets.empty())
+        return false;
+
+    const auto expected = hash_to_range(targets, count * rate, key);
+    auto target = expected.begin();
+    size_t offset = 0;
+    uint64_t value = 0;
+
+    for (uint64_t index = 0; index < count; ++index)
+    {
+        uint64_t delta;
+        if (!golomb_decode(delta, set, offset, bits))
+            return false;
+
+        value += delta;
+
+        while (*target < value)
+            if (++target == expected.end())
+                return false;
+
+        if (*target == value)
+            return true;
+    }
+
+    return false;
+}
+
+} // namespace libbitcoin
@@ -40,6 +40,19 @@ hash_digest bitcoin_hash(data_slice data)
     return sha256_hash(sha256_hash(data));
 }
 
+hash_digest bitcoin_hash(loaf slices)
+{
+    hash_digest hash;
+    SHA256CTX context;
+    SHA256Init(&context);
+
+    for (const auto& slice: slices)
+        SHA256Update(&context, slice.data(), slice.size());
+
+    SHA256Final(&context, hash.data());
+    return sha256_hash(hash);
+}
+
 hash_digest scrypt_hash(data_slice data)
 {
     return scrypt<hash_size>(data, data, 1024u, 1u, 1u);
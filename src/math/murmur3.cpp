@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/murmur3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+// MurmurHash3_x86_32, see https://github.com/aappleby/smhasher
+
+static BC_CONSTEXPR uint32_t murmur_c1 = 0xcc9e2d51;
+static BC_CONSTEXPR uint32_t murmur_c2 = 0x1b873593;
+static BC_CONSTEXPR size_t murmur_block_size = sizeof(uint32_t);
+
+static inline uint32_t rotate_left(uint32_t value, size_t bits)
+{
+    return (value << bits) | (value >> (32 - bits));
+}
+
+static inline uint32_t scramble(uint32_t word)
+{
+    return rotate_left(word * murmur_c1, 15) * murmur_c2;
+}
+
+uint32_t murmur3(uint32_t seed, data_slice data)
+{
+    auto hash = seed;
+    const auto size = data.size();
+    const auto blocks = size / murmur_block_size;
+    auto bytes = data.data();
+
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        hash ^= scramble(from_little_endian_unsafe<uint32_t>(bytes));
+        hash = rotate_left(hash, 13) * 5 + 0xe6546b64;
+        bytes += murmur_block_size;
+    }
+
+    const auto remainder = size % murmur_block_size;
+
+    if (remainder != 0)
+    {
+        uint32_t word = 0;
+        for (size_t byte = 0; byte < remainder; ++byte)
+            word |= static_cast<uint32_t>(bytes[byte]) << (8 * byte);
+
+        hash ^= scramble(word);
+    }
+
+    // Finalization mixes the length and avalanches the result.
+    hash ^= static_cast<uint32_t>(size);
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+} // namespace libbitcoin
@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/siphash.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+// SipHash-2-4, see https://131002.net/siphash/siphash.pdf
+
+static BC_CONSTEXPR uint64_t sip_v0 = 0x736f6d6570736575;
+static BC_CONSTEXPR uint64_t sip_v1 = 0x646f72616e646f6d;
+static BC_CONSTEXPR uint64_t sip_v2 = 0x6c7967656e657261;
+static BC_CONSTEXPR uint64_t sip_v3 = 0x7465646279746573;
+static BC_CONSTEXPR uint64_t sip_final = 0xff;
+static BC_CONSTEXPR size_t sip_block_size = sizeof(uint64_t);
+
+static inline uint64_t rotate_left(uint64_t value, size_t bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline void sip_round(uint64_t& v0, uint64_t& v1, uint64_t& v2,
+    uint64_t& v3)
+{
+    v0 += v1;
+    v1 = rotate_left(v1, 13);
+    v1 ^= v0;
+    v0 = rotate_left(v0, 32);
+    v2 += v3;
+    v3 = rotate_left(v3, 16);
+    v3 ^= v2;
+    v0 += v3;
+    v3 = rotate_left(v3, 21);
+    v3 ^= v0;
+    v2 += v1;
+    v1 = rotate_left(v1, 17);
+    v1 ^= v2;
+    v2 = rotate_left(v2, 32);
+}
+
+static inline void compression_round(uint64_t& v0, uint64_t& v1,
+    uint64_t& v2, uint64_t& v3, uint64_t word)
+{
+    v3 ^= word;
+    sip_round(v0, v1, v2, v3);
+    sip_round(v0, v1, v2, v3);
+    v0 ^= word;
+}
+
+uint64_t siphash(const siphash_key& key, data_slice message)
+{
+    const auto k0 = std::get<0>(key);
+    const auto k1 = std::get<1>(key);
+
+    auto v0 = sip_v0 ^ k0;
+    auto v1 = sip_v1 ^ k1;
+    auto v2 = sip_v2 ^ k0;
+    auto v3 = sip_v3 ^ k1;
+
+    const auto size = message.size();
+    const auto blocks = size / sip_block_size;
+    auto data = message.data();
+
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        const auto word = from_little_endian_unsafe<uint64_t>(data);
+        compression_round(v0, v1, v2, v3, word);
+        data += sip_block_size;
+    }
+
+    // The final word carries the remaining bytes and the message length.
+    auto last = static_cast<uint64_t>(size) << 56;
+
+    for (size_t byte = 0; byte < size % sip_block_size; ++byte)
+        last |= static_cast<uint64_t>(data[byte]) << (8 * byte);
+
+    compression_round(v0, v1, v2, v3, last);
+
+    v2 ^= sip_final;
+    sip_round(v0, v1, v2, v3);
+    sip_round(v0, v1, v2, v3);
+    sip_round(v0, v1, v2, v3);
+    sip_round(v0, v1, v2, v3);
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+uint64_t siphash(const half_hash& hash, data_slice message)
+{
+    return siphash(to_siphash_key(hash), message);
+}
+
+siphash_key to_siphash_key(const half_hash& hash)
+{
+    const auto first = hash.begin();
+    const auto second = first + sizeof(uint64_t);
+    return std::make_tuple(from_little_endian_unsafe<uint64_t>(first),
+        from_little_endian_unsafe<uint64_t>(second));
+}
+
+} // namespace libbitcoin
@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <istream>
 #include <utility>
+#include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
@@ -57,38 +58,52 @@ block block::factory(uint32_t version, reader& source)
 }
 
 block::block()
-  : chain::block()
+  : chain::block(),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
 block::block(block&& other)
-  : chain::block(std::move(other))
+  : chain::block(std::move(other)),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
 block::block(const block& other)
-  : chain::block(other)
+  : chain::block(other),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
 block::block(chain::block&& other)
-  : chain::block(std::move(other))
+  : chain::block(std::move(other)),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
-block::block( chain::block& other)
-  : chain::block(other)
+block::block(const chain::block& other)
+  : chain::block(other),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
 block::block(chain::header&& header, chain::transaction::list&& transactions)
-  : chain::block(std::move(header), std::move(transactions))
+  : chain::block(std::move(header), std::move(transactions)),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
-block::block( chain::header& header,
-     chain::transaction::list& transactions)
-  : chain::block(header, transactions)
+block::block(const chain::header& header,
+    const chain::transaction::list& transactions)
+  : chain::block(header, transactions),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
@@ -133,35 +148,103 @@ size_t block::serialized_size(uint32_t) const
     return chain::block::serialized_size(true);
 }
 
+block::wire_ptr block::to_wire(uint32_t version, uint32_t magic,
+    bool witness) const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    wire_mutex_.lock_upgrade();
+
+    // Any modification of the block advances its revision.
+    const auto revision = chain::block::revision();
+
+    if (!wire_ || wire_revision_ != revision || wire_version_ != version ||
+        wire_magic_ != magic || wire_witness_ != witness)
+    {
+        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+        wire_mutex_.unlock_upgrade_and_lock();
+        wire_.reset();
+
+        // The payload is independent of version, witness may be excluded.
+        const auto payload = [this, witness](writer& sink)
+        {
+            chain::block::to_data(sink, witness);
+        };
+
+        data_chunk data;
+        const auto payload_size = chain::block::serialized_size(witness);
+
+        if (write_message(data, command, magic, payload_size, payload))
+        {
+            wire_ = std::make_shared<const data_chunk>(std::move(data));
+            wire_revision_ = revision;
+            wire_version_ = version;
+            wire_magic_ = magic;
+            wire_witness_ = witness;
+        }
+
+        wire_mutex_.unlock_and_lock_upgrade();
+        //---------------------------------------------------------------------
+    }
+
+    const auto wire = wire_ ? wire_ : std::make_shared<const data_chunk>();
+    wire_mutex_.unlock_upgrade();
+    ///////////////////////////////////////////////////////////////////////////
+
+    return wire;
+}
+
+// private
+void block::invalidate_wire() const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    wire_mutex_.lock_upgrade();
+
+    if (wire_)
+    {
+        wire_mutex_.unlock_upgrade_and_lock();
+        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+        wire_.reset();
+        //---------------------------------------------------------------------
+        wire_mutex_.unlock_and_lock_upgrade();
+    }
+
+    wire_mutex_.unlock_upgrade();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
 block& block::operator=(chain::block&& other)
 {
     reset();
     chain::block::operator=(std::move(other));
+    invalidate_wire();
     return *this;
 }
 
 block& block::operator=(block&& other)
 {
     chain::block::operator=(std::move(other));
+    invalidate_wire();
     return *this;
 }
 
-bool block::operator==( chain::block& other) const
+bool block::operator==(const chain::block& other) const
 {
     return chain::block::operator==(other);
 }
 
-bool block::operator!=( chain::block& other) const
+bool block::operator!=(const chain::block& other) const
 {
     return chain::block::operator!=(other);
 }
 
-bool block::operator==( block& other) const
+bool block::operator==(const block& other) const
 {
     return chain::block::operator==(other);
 }
 
-bool block::operator!=( block& other) const
+bool block::operator!=(const block& other) const
 {
     return !(*this == other);
 }
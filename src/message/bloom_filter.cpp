@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/bloom_filter.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/machine/script_pattern.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/murmur3.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+using namespace bc::chain;
+using namespace bc::machine;
+
+// The BIP37 seed multiplier for successive hash functions.
+static BC_CONSTEXPR uint32_t seed_multiplier = 0xfba4c795;
+static BC_CONSTEXPR size_t outpoint_size = hash_size + sizeof(uint32_t);
+
+static byte_array<outpoint_size> to_outpoint(const hash_digest& hash,
+    uint32_t index)
+{
+    byte_array<outpoint_size> out;
+    build_array(out, { hash, to_little_endian(index) });
+    return out;
+}
+
+bloom_filter::bloom_filter()
+  : filter_(), hash_functions_(0), tweak_(0), flags_(update_none),
+    empty_(true), full_(false)
+{
+}
+
+bloom_filter::bloom_filter(const filter_load& load)
+  : bloom_filter(data_chunk(load.filter()), load.hash_functions(),
+      load.tweak(), load.flags())
+{
+}
+
+bloom_filter::bloom_filter(data_chunk&& filter, uint32_t hash_functions,
+    uint32_t tweak, uint8_t flags)
+  : filter_(std::move(filter)),
+    hash_functions_(hash_functions),
+    tweak_(tweak),
+    flags_(flags),
+    empty_(true),
+    full_(false)
+{
+    update_empty_full();
+}
+
+bool bloom_filter::is_valid() const
+{
+    return filter_.size() <= max_filter_load &&
+        hash_functions_ <= max_filter_functions;
+}
+
+size_t bloom_filter::bit_index(uint32_t function, data_slice element) const
+{
+    const auto seed = function * seed_multiplier + tweak_;
+    return murmur3(seed, element) % (filter_.size() * byte_bits);
+}
+
+void bloom_filter::insert(data_slice element)
+{
+    if (filter_.empty() || full_)
+        return;
+
+    for (uint32_t function = 0; function < hash_functions_; ++function)
+    {
+        const auto index = bit_index(function, element);
+        filter_[index / byte_bits] |= (1u << (index % byte_bits));
+    }
+
+    empty_ = false;
+}
+
+bool bloom_filter::contains(data_slice element) const
+{
+    if (full_)
+        return true;
+
+    if (empty_)
+        return false;
+
+    for (uint32_t function = 0; function < hash_functions_; ++function)
+    {
+        const auto index = bit_index(function, element);
+        if ((filter_[index / byte_bits] & (1u << (index % byte_bits))) == 0)
+            return false;
+    }
+
+    return true;
+}
+
+// Script pushes are tested in place, without copying the push data.
+bool bloom_filter::matches(const script& script) const
+{
+    for (const auto& token: script.tokens())
+    {
+        if (!token.valid)
+            break;
+
+        const auto data = script.payload(token);
+        if (!data.empty() && contains(data))
+            return true;
+    }
+
+    return false;
+}
+
+bool bloom_filter::matches(const transaction& tx)
+{
+    if (full_)
+        return true;
+
+    if (empty_)
+        return false;
+
+    const auto hash = tx.hash();
+    const auto update = flags_ & update_mask;
+    auto matched = contains(hash);
+    uint32_t index = 0;
+
+    // All outputs are tested so that each matching outpoint may be added.
+    for (const auto& output: tx.outputs())
+    {
+        const auto& script = output.script();
+
+        if (matches(script))
+        {
+            matched = true;
+
+            if (update == update_all ||
+                (update == update_p2pubkey_only &&
+                (script.output_pattern() == script_pattern::pay_public_key ||
+                script.output_pattern() == script_pattern::pay_multisig)))
+                insert(to_outpoint(hash, index));
+        }
+
+        ++index;
+    }
+
+    if (matched)
+        return true;
+
+    for (const auto& input: tx.inputs())
+    {
+        const auto& prevout = input.previous_output();
+
+        if (contains(to_outpoint(prevout.hash(), prevout.index())) ||
+            matches(input.script()))
+            return true;
+    }
+
+    return false;
+}
+
+void bloom_filter::update_empty_full()
+{
+    const auto clear = [](uint8_t byte) { return byte == 0x00; };
+    const auto set = [](uint8_t byte) { return byte == 0xff; };
+
+    empty_ = std::all_of(filter_.begin(), filter_.end(), clear);
+    full_ = !filter_.empty() && std::all_of(filter_.begin(), filter_.end(), set);
+}
+
+const data_chunk& bloom_filter::filter() const
+{
+    return filter_;
+}
+
+uint32_t bloom_filter::hash_functions() const
+{
+    return hash_functions_;
+}
+
+uint32_t bloom_filter::tweak() const
+{
+    return tweak_;
+}
+
+uint8_t bloom_filter::flags() const
+{
+    return flags_;
+}
+
+} // namespace message
+} // namespace libbitcoin
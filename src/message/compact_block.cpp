@@ -18,12 +18,19 @@
  */
 #include <bitcoin/bitcoin/message/compact_block.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
 
@@ -55,12 +62,43 @@ compact_block compact_block::factory(uint32_t version, reader& source)
     return instance;
 }
 
+compact_block compact_block::factory(const chain::block& block,
+    uint64_t nonce, bool witness)
+{
+    compact_block instance;
+    instance.header_ = block.header();
+    instance.nonce_ = nonce;
+
+    const auto& transactions = block.transactions();
+
+    if (transactions.empty())
+        return instance;
+
+    // The coinbase cannot be known to the peer, so it is always prefilled.
+    instance.transactions_.emplace_back(0, transactions.front());
+    instance.short_ids_.reserve(transactions.size() - 1);
+    const auto key = instance.short_id_key();
+
+    for (auto tx = std::next(transactions.begin()); tx != transactions.end();
+        ++tx)
+        instance.short_ids_.push_back(to_short_id(key, tx->hash(witness)));
+
+    return instance;
+}
+
+compact_block::short_id compact_block::to_short_id(const siphash_key& key,
+    const hash_digest& hash)
+{
+    // The short id is the low 48 bits of the siphash, little-endian.
+    return slice<0, mini_hash_size>(to_little_endian(siphash(key, hash)));
+}
+
 compact_block::compact_block()
   : header_(), nonce_(0), short_ids_(), transactions_()
 {
 }
 
-compact_block::compact_block( chain::header& header, uint64_t nonce,
+compact_block::compact_block(const chain::header& header, uint64_t nonce,
     const short_id_list& short_ids,
     const prefilled_transaction::list& transactions)
   : header_(header),
@@ -79,7 +117,7 @@ compact_block::compact_block(chain::header&& header, uint64_t nonce,
 {
 }
 
-compact_block::compact_block( compact_block& other)
+compact_block::compact_block(const compact_block& other)
   : compact_block(other.header_, other.nonce_, other.short_ids_,
       other.transactions_)
 {
@@ -216,7 +254,7 @@ const chain::header& compact_block::header() const
     return header_;
 }
 
-void compact_block::set_header( chain::header& value)
+void compact_block::set_header(const chain::header& value)
 {
     header_ = value;
 }
@@ -276,6 +314,129 @@ void compact_block::set_transactions(prefilled_transaction::list&& value)
     transactions_ = std::move(value);
 }
 
+siphash_key compact_block::short_id_key() const
+{
+    // The key is the first half of sha256(header || nonce).
+    auto data = header_.to_data();
+    extend_data(data, to_little_endian(nonce_));
+    return to_siphash_key(slice<0, half_hash_size>(sha256_hash(data)));
+}
+
+bool compact_block::reconstruct(chain::block& out,
+    get_block_transactions& missing, const chain::transaction::list& known,
+    bool witness) const
+{
+    const auto count = short_ids_.size() + transactions_.size();
+    chain::transaction::list transactions(count);
+    std::vector<bool> filled(count, false);
+    size_t position = 0;
+
+    // Prefilled indexes are differentially encoded.
+    for (const auto& prefilled: transactions_)
+    {
+        if (prefilled.index() >= count - position)
+            return false;
+
+        position += prefilled.index();
+        transactions[position] = prefilled.transaction();
+        filled[position++] = true;
+    }
+
+    std::unordered_map<short_id, size_t> positions;
+    positions.reserve(short_ids_.size());
+    position = 0;
+
+    // Short ids occupy the remaining positions in order.
+    for (const auto& id: short_ids_)
+    {
+        while (filled[position])
+            ++position;
+
+        // Duplicate short ids cannot be resolved without the full block.
+        if (!positions.emplace(id, position++).second)
+            return false;
+    }
+
+    std::vector<bool> collided(count, false);
+    const auto key = short_id_key();
+
+    // A second distinct match for a position is a collision, so the position
+    // is left for the peer to fill.
+    for (const auto& tx: known)
+    {
+        const auto hash = tx.hash(witness);
+        const auto match = positions.find(to_short_id(key, hash));
+
+        if (match == positions.end() || collided[match->second])
+            continue;
+
+        auto& slot = transactions[match->second];
+
+        if (!filled[match->second])
+        {
+            slot = tx;
+            filled[match->second] = true;
+        }
+        else if (slot.hash(witness) != hash)
+        {
+            slot = chain::transaction();
+            filled[match->second] = false;
+            collided[match->second] = true;
+        }
+    }
+
+    std::vector<uint64_t> indexes;
+    size_t offset = 0;
+
+    // Missing indexes are differentially encoded.
+    for (position = 0; position < count; ++position)
+    {
+        if (!filled[position])
+        {
+            indexes.push_back(position - offset);
+            offset = position + 1;
+        }
+    }
+
+    missing.set_block_hash(header_.hash());
+    missing.set_indexes(std::move(indexes));
+    out = chain::block(chain::header(header_), std::move(transactions));
+    return !missing.indexes().empty() || out.is_valid_merkle_root();
+}
+
+bool compact_block::reconstruct(chain::block& out,
+    const get_block_transactions& missing,
+    const block_transactions& response)
+{
+    const auto& indexes = missing.indexes();
+    const auto& transactions = response.transactions();
+
+    if (response.block_hash() != missing.block_hash() ||
+        transactions.size() != indexes.size())
+        return false;
+
+    auto filled = std::move(out.transactions());
+    auto tx = transactions.begin();
+    size_t position = 0;
+    auto valid = true;
+
+    // Missing indexes are differentially encoded.
+    for (const auto index: indexes)
+    {
+        if (index >= filled.size() - position)
+        {
+            valid = false;
+            break;
+        }
+
+        position += index;
+        filled[position++] = *tx++;
+    }
+
+    out.set_transactions(std::move(filled));
+    return valid && out.is_valid_merkle_root();
+}
+
 compact_block& compact_block::operator=(compact_block&& other)
 {
     header_ = std::move(other.header_);
@@ -86,7 +86,7 @@ header::header(uint32_t version,
 {
 }
 
-header::header( chain::header& other)
+header::header(const chain::header& other)
   : chain::header(other)
 {
 }
@@ -96,7 +96,7 @@ header::header(chain::header&& other)
 {
 }
 
-header::header( header& other)
+header::header(const header& other)
   : chain::header(other)
 {
 }
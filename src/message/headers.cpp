@@ -19,19 +19,26 @@
 #include <bitcoin/bitcoin/message/headers.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <istream>
+#include <memory>
 #include <utility>
+#include <vector>
+#include <bitcoin/bitcoin/chain/chain_state.hpp>
+#include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/inventory.hpp>
 #include <bitcoin/bitcoin/message/inventory_vector.hpp>
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
+#include <bitcoin/bitcoin/settings.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace message {
@@ -67,7 +74,7 @@ headers::headers()
 }
 
 // Uses headers copy assignment.
-headers::headers( header::list& values)
+headers::headers(const header::list& values)
   : elements_(values)
 {
 }
@@ -77,12 +84,12 @@ headers::headers(header::list&& values)
 {
 }
 
-//headers::headers(const std::initializer_list<header>& values)
-//  : elements_(values)
-//{
-//}
+headers::headers(const std::initializer_list<header>& values)
+  : elements_(values)
+{
+}
 
-headers::headers( headers& other)
+headers::headers(const headers& other)
   : headers(other.elements_)
 {
 }
@@ -210,6 +217,54 @@ void headers::to_inventory(inventory_vector::list& out,
     std::for_each(elements_.begin(), elements_.end(), map);
 }
 
+// Hashing dominates and is independent across headers, so it is done on the
+// pool along with the context-free checks. Results are evaluated in order,
+// so the first reported error is the same as for serial validation.
+code headers::validate(const chain::chain_state& parent, threadpool& pool,
+    settings& settings, size_t& index, bool scrypt)
+{
+    const auto count = elements_.size();
+    std::vector<code> checks(count);
+
+    const auto check = [this, &checks, &settings, scrypt](size_t position)
+    {
+        // Cache the hash for linkage and checkpoints (and proof of work).
+        elements_[position].hash();
+        checks[position] = elements_[position].check(
+            settings.timestamp_limit_seconds, settings.proof_of_work_limit,
+            scrypt);
+    };
+
+    parallel_for(pool, count, check);
+
+    auto state = &parent;
+    auto previous = parent.hash();
+
+    for (index = 0; index < count; ++index)
+    {
+        code ec;
+        auto& header = elements_[index];
+
+        if ((ec = checks[index]))
+            return ec;
+
+        if (header.previous_block_hash() != previous)
+            return error::invalid_previous_block;
+
+        // Each state is promoted from its predecessor, not rebuilt.
+        header.metadata.state = std::make_shared<chain::chain_state>(*state,
+            header, settings);
+        state = header.metadata.state.get();
+
+        if ((ec = header.accept(*state)))
+            return ec;
+
+        previous = header.hash();
+    }
+
+    return error::success;
+}
+
 size_t headers::serialized_size(uint32_t version) const
 {
     return variable_uint_size(elements_.size()) +
@@ -221,10 +276,10 @@ header::list& headers::elements()
     return elements_;
 }
 
-//const header::list& headers::elements() const
-//{
-//    return elements_;
-//}
+const header::list& headers::elements() const
+{
+    return elements_;
+}
 
 void headers::set_elements(const header::list& values)
 {
@@ -25,6 +25,7 @@
 #include <bitcoin/bitcoin/message/inventory.hpp>
 #include <bitcoin/bitcoin/message/inventory_vector.hpp>
 #include <bitcoin/bitcoin/message/messages.hpp>
+#include <bitcoin/bitcoin/message/rolling_filter.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
@@ -176,26 +177,35 @@ void inventory::to_data(uint32_t version, writer& sink) const
         inventory.to_data(version, sink);
 }
 
+// Counting first sizes the result exactly, avoiding a shrinking copy.
 void inventory::to_hashes(hash_list& out, type_id type) const
 {
-    out.reserve(inventories_.size());
+    out.reserve(out.size() + count(type));
 
     for (const auto& element: inventories_)
         if (element.type() == type)
             out.push_back(element.hash());
-
-    out.shrink_to_fit();
 }
 
+// Counting first sizes the result exactly, avoiding a shrinking copy.
 void inventory::reduce(inventory_vector::list& out, type_id type) const
 {
-    out.reserve(inventories_.size());
+    out.reserve(out.size() + count(type));
 
     for (const auto& inventory: inventories_)
         if (inventory.type() == type)
             out.push_back(inventory);
+}
+
+void inventory::filter_unknown(const rolling_filter& known)
+{
+    const auto is_known = [&known](const inventory_vector& element)
+    {
+        return known.contains(element);
+    };
 
-    out.shrink_to_fit();
+    inventories_.erase(std::remove_if(inventories_.begin(),
+        inventories_.end(), is_known), inventories_.end());
 }
 
 size_t inventory::serialized_size(uint32_t version) const
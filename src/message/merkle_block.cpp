@@ -18,8 +18,14 @@
  */
 #include <bitcoin/bitcoin/message/merkle_block.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 #include <bitcoin/bitcoin/chain/block.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/math/limits.hpp>
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
@@ -36,6 +42,150 @@ const std::string merkle_block::command = "merkleblock";
 const uint32_t merkle_block::version_minimum = version::level::bip37;
 const uint32_t merkle_block::version_maximum = version::level::maximum;
 
+// Partial merkle tree (BIP37).
+//-----------------------------------------------------------------------------
+// Nodes are visited depth first. Each visit consumes a flag bit, set if the
+// subtree contains a match, and a hash for each unmatched subtree or leaf.
+
+static size_t tree_width(size_t total, size_t height)
+{
+    return (total + (size_t(1) << height) - 1) >> height;
+}
+
+static size_t tree_height(size_t total)
+{
+    size_t height = 0;
+    while (tree_width(total, height) > 1)
+        ++height;
+
+    return height;
+}
+
+// The pair is hashed from the slices, without concatenating them.
+static hash_digest merkle_hash(const hash_digest& left,
+    const hash_digest& right)
+{
+    return bitcoin_hash({ left, right });
+}
+
+static hash_digest subtree_hash(const hash_list& leaves, size_t height,
+    size_t position)
+{
+    if (height == 0)
+        return leaves[position];
+
+    const auto left = subtree_hash(leaves, height - 1, position * 2);
+
+    if (position * 2 + 1 < tree_width(leaves.size(), height - 1))
+        return merkle_hash(left,
+            subtree_hash(leaves, height - 1, position * 2 + 1));
+
+    return merkle_hash(left, left);
+}
+
+static void build_tree(hash_list& hashes, data_chunk& flags, size_t& bits,
+    const hash_list& leaves, const std::vector<bool>& matches, size_t height,
+    size_t position)
+{
+    const auto total = leaves.size();
+    const auto first = position << height;
+    const auto last = std::min((position + 1) << height, total);
+    auto parent = false;
+
+    for (auto leaf = first; leaf < last && !parent; ++leaf)
+        parent = leaf < matches.size() && matches[leaf];
+
+    if (bits % byte_bits == 0)
+        flags.push_back(0x00);
+
+    if (parent)
+        flags.back() |= (1u << (bits % byte_bits));
+
+    ++bits;
+
+    if (height == 0 || !parent)
+    {
+        hashes.push_back(subtree_hash(leaves, height, position));
+        return;
+    }
+
+    build_tree(hashes, flags, bits, leaves, matches, height - 1, position * 2);
+
+    if (position * 2 + 1 < tree_width(total, height - 1))
+        build_tree(hashes, flags, bits, leaves, matches, height - 1,
+            position * 2 + 1);
+}
+
+static std::vector<bool> filter_matches(const chain::block& block,
+    bloom_filter& filter)
+{
+    const auto& transactions = block.transactions();
+    std::vector<bool> matches;
+    matches.reserve(transactions.size());
+
+    for (const auto& tx: transactions)
+        matches.push_back(filter.matches(tx));
+
+    return matches;
+}
+
+static bool traverse_tree(hash_digest& out, hash_list& out_hashes,
+    merkle_block::indexes& out_indexes, size_t& bits, size_t& used,
+    const merkle_block& block, size_t height, size_t position)
+{
+    const auto& flags = block.flags();
+    const auto& hashes = block.hashes();
+
+    if (bits >= flags.size() * byte_bits)
+        return false;
+
+    const auto parent = ((flags[bits / byte_bits] >> (bits % byte_bits)) &
+        1u) != 0;
+    ++bits;
+
+    if (height == 0 || !parent)
+    {
+        if (used >= hashes.size())
+            return false;
+
+        out = hashes[used++];
+
+        if (height == 0 && parent)
+        {
+            out_hashes.push_back(out);
+            out_indexes.push_back(position);
+        }
+
+        return true;
+    }
+
+    hash_digest left;
+    hash_digest right;
+
+    if (!traverse_tree(left, out_hashes, out_indexes, bits, used, block,
+        height - 1, position * 2))
+        return false;
+
+    if (position * 2 + 1 < tree_width(block.total_transactions(), height - 1))
+    {
+        if (!traverse_tree(right, out_hashes, out_indexes, bits, used, block,
+            height - 1, position * 2 + 1))
+            return false;
+
+        // Identical siblings would allow a duplicated transaction to be proven
+        // against the same root (CVE-2012-2459).
+        if (right == left)
+            return false;
+    }
+    else
+    {
+        right = left;
+    }
+
+    out = merkle_hash(left, right);
+    return true;
+}
+
 merkle_block merkle_block::factory(uint32_t version, const data_chunk& data)
 {
     merkle_block instance;
@@ -62,7 +212,7 @@ merkle_block::merkle_block()
 {
 }
 
-merkle_block::merkle_block( chain::header& header,
+merkle_block::merkle_block(const chain::header& header,
     size_t total_transactions, const hash_list& hashes,
     const data_chunk& flags)
   : header_(header), total_transactions_(total_transactions), hashes_(hashes),
@@ -79,14 +229,36 @@ merkle_block::merkle_block(chain::header&& header, size_t total_transactions,
 
 // Hack: use of safe_unsigned here isn't great. We should consider using size_t
 // for the transaction count and invalidating on deserialization and construct.
-merkle_block::merkle_block( chain::block& block)
+merkle_block::merkle_block(const chain::block& block)
   : merkle_block(block.header(),
         safe_unsigned<uint32_t>(block.transactions().size()),
         block.to_hashes(), {})
 {
 }
 
-merkle_block::merkle_block( merkle_block& other)
+merkle_block::merkle_block(const chain::block& block,
+    const std::vector<bool>& matches)
+  : header_(block.header()),
+    total_transactions_(block.transactions().size()),
+    hashes_(),
+    flags_()
+{
+    if (total_transactions_ == 0)
+        return;
+
+    size_t bits = 0;
+    const auto leaves = block.to_hashes();
+    build_tree(hashes_, flags_, bits, leaves, matches,
+        tree_height(total_transactions_), 0);
+}
+
+merkle_block::merkle_block(const chain::block& block,
+    bloom_filter& filter)
+  : merkle_block(block, filter_matches(block, filter))
+{
+}
+
+merkle_block::merkle_block(const merkle_block& other)
   : merkle_block(other.header_, other.total_transactions_, other.hashes_,
       other.flags_)
 {
@@ -113,6 +285,34 @@ void merkle_block::reset()
     flags_.shrink_to_fit();
 }
 
+bool merkle_block::extract_matches(hash_list& out_hashes,
+    indexes& out_indexes) const
+{
+    out_hashes.clear();
+    out_indexes.clear();
+
+    // Each hash is of a distinct subtree and each subtree consumes a flag bit.
+    if (total_transactions_ == 0 || total_transactions_ > max_block_size ||
+        hashes_.size() > total_transactions_ ||
+        hashes_.size() > flags_.size() * byte_bits)
+        return false;
+
+    size_t bits = 0;
+    size_t used = 0;
+    hash_digest root;
+
+    if (!traverse_tree(root, out_hashes, out_indexes, bits, used, *this,
+        tree_height(total_transactions_), 0))
+        return false;
+
+    // All hashes and all flag bytes must be consumed.
+    if (used != hashes_.size() ||
+        (bits + byte_bits - 1) / byte_bits != flags_.size())
+        return false;
+
+    return root == header_.merkle();
+}
+
 bool merkle_block::from_data(uint32_t version, const data_chunk& data)
 {
     data_source istream(data);
@@ -205,7 +405,7 @@ const chain::header& merkle_block::header() const
     return header_;
 }
 
-void merkle_block::set_header( chain::header& value)
+void merkle_block::set_header(const chain::header& value)
 {
     header_ = value;
 }
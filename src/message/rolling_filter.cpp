@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/rolling_filter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/message/inventory_vector.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/pseudo_random.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+typedef inventory_vector::type_id type_id;
+
+static const size_t generations = 3;
+static const size_t word_bits = 64;
+
+// The optimal number of hash functions for the false positive rate.
+static size_t hash_function_count(double false_positive_rate)
+{
+    const auto functions = std::round(std::log(false_positive_rate) /
+        std::log(0.5));
+    return static_cast<size_t>(std::max(1.0, std::min(functions,
+        static_cast<double>(max_filter_functions))));
+}
+
+// The number of word pairs (each of two generation bits per filter bit).
+static size_t word_pair_count(size_t elements, size_t functions,
+    double false_positive_rate)
+{
+    const auto k = static_cast<double>(functions);
+    const auto bits = std::ceil(-k * elements /
+        std::log(1.0 - std::exp(std::log(false_positive_rate) / k)));
+    return std::max(size_t(1), (static_cast<size_t>(bits) + word_bits - 1) /
+        word_bits);
+}
+
+rolling_filter::rolling_filter(size_t capacity, double false_positive_rate)
+  : rolling_filter(capacity, false_positive_rate,
+      siphash_key(pseudo_random::next(), pseudo_random::next()))
+{
+}
+
+rolling_filter::rolling_filter(size_t capacity, double false_positive_rate,
+    const siphash_key& key)
+  : key_(key),
+    generation_capacity_((capacity + 1) / 2),
+    hash_functions_(hash_function_count(false_positive_rate)),
+    generation_size_(0),
+    generation_(1),
+    data_(2 * word_pair_count(generations * generation_capacity_,
+        hash_functions_, false_positive_rate), 0)
+{
+    BITCOIN_ASSERT(false_positive_rate > 0.0 && false_positive_rate < 1.0);
+}
+
+size_t rolling_filter::hash_functions() const
+{
+    return hash_functions_;
+}
+
+size_t rolling_filter::size() const
+{
+    return data_.size() * sizeof(uint64_t);
+}
+
+void rolling_filter::reset()
+{
+    generation_size_ = 0;
+    generation_ = 1;
+    std::fill(data_.begin(), data_.end(), 0);
+}
+
+// The witness flag is masked so that witness and non-witness announcements of
+// the same object are treated as the same inventory.
+uint64_t rolling_filter::hash(const inventory_vector& inventory) const
+{
+    static const auto witness = inventory_vector::to_number(type_id::witness);
+    const auto type = inventory_vector::to_number(inventory.type()) & ~witness;
+
+    byte_array<sizeof(uint32_t) + hash_size> element;
+    build_array(element, { to_little_endian(type), inventory.hash() });
+    return siphash(key_, element);
+}
+
+// Map the value onto the first word of a pair without division.
+size_t rolling_filter::position(uint32_t value) const
+{
+    const uint64_t pairs = data_.size() / 2;
+    return static_cast<size_t>((uint64_t(value) * pairs) >> 32) * 2;
+}
+
+// Start the next generation, clearing all bits of the one it replaces.
+void rolling_filter::roll()
+{
+    generation_size_ = 0;
+    generation_ = generation_ == generations ? 1 : generation_ + 1;
+
+    // Masks of the generation in each word of the pair (all set or clear).
+    const uint64_t low = 0 - static_cast<uint64_t>(generation_ & 1);
+    const uint64_t high = 0 - static_cast<uint64_t>(generation_ >> 1);
+
+    for (size_t index = 0; index < data_.size(); index += 2)
+    {
+        const auto first = data_[index];
+        const auto second = data_[index + 1];
+        const auto keep = (first ^ low) | (second ^ high);
+        data_[index] = first & keep;
+        data_[index + 1] = second & keep;
+    }
+}
+
+void rolling_filter::insert(const inventory_vector& inventory)
+{
+    if (generation_size_ == generation_capacity_)
+        roll();
+
+    ++generation_size_;
+    const auto digest = hash(inventory);
+    const auto base = static_cast<uint32_t>(digest);
+    const auto step = static_cast<uint32_t>(digest >> 32);
+    const uint64_t low = generation_ & 1;
+    const uint64_t high = generation_ >> 1;
+
+    // Derive each function from the one hash (Kirsch-Mitzenmacher).
+    for (uint32_t function = 0; function < hash_functions_; ++function)
+    {
+        const auto value = base + function * step;
+        const auto bit = value % word_bits;
+        const auto index = position(value);
+        data_[index] = (data_[index] & ~(uint64_t(1) << bit)) | (low << bit);
+        data_[index + 1] = (data_[index + 1] & ~(uint64_t(1) << bit)) |
+            (high << bit);
+    }
+}
+
+bool rolling_filter::contains(const inventory_vector& inventory) const
+{
+    const auto digest = hash(inventory);
+    const auto base = static_cast<uint32_t>(digest);
+    const auto step = static_cast<uint32_t>(digest >> 32);
+
+    for (uint32_t function = 0; function < hash_functions_; ++function)
+    {
+        const auto value = base + function * step;
+        const auto bit = value % word_bits;
+        const auto index = position(value);
+
+        // A bit is set in any generation if either word of its pair is set.
+        if ((((data_[index] | data_[index + 1]) >> bit) & 1) == 0)
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace message
+} // namespace libbitcoin
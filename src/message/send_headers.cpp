@@ -141,6 +141,10 @@ void send_headers::to_data(uint32_t, std::ostream&) const
 {
 }
 
+void send_headers::to_data(uint32_t, writer&) const
+{
+}
+
 size_t send_headers::serialized_size(uint32_t version) const
 {
     return send_headers::satoshi_fixed_size(version);
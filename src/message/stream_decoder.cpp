@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/message/stream_decoder.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/math/checksum.hpp>
+#include <bitcoin/bitcoin/message/heading.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/buffer_pool.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+
+namespace libbitcoin {
+namespace message {
+
+stream_decoder::stream_decoder(uint32_t magic, uint32_t version, bool witness)
+  : magic_(magic),
+    maximum_payload_(heading::maximum_payload_size(version, witness)),
+    heading_(),
+    have_heading_(false),
+    buffer_(),
+    pool_(nullptr)
+{
+}
+
+stream_decoder::stream_decoder(uint32_t magic, uint32_t version,
+    bool witness, buffer_pool& pool)
+  : magic_(magic),
+    maximum_payload_(heading::maximum_payload_size(version, witness)),
+    heading_(),
+    have_heading_(false),
+    buffer_(),
+    pool_(&pool)
+{
+}
+
+stream_decoder::~stream_decoder()
+{
+    if (pool_ != nullptr && buffer_.capacity() != 0)
+        pool_->release(std::move(buffer_));
+}
+
+size_t stream_decoder::buffered() const
+{
+    return buffer_.size();
+}
+
+size_t stream_decoder::capacity() const
+{
+    return buffer_.capacity();
+}
+
+void stream_decoder::reset()
+{
+    heading_.reset();
+    have_heading_ = false;
+
+    if (pool_ != nullptr && buffer_.capacity() != 0)
+    {
+        pool_->release(std::move(buffer_));
+        buffer_ = data_chunk();
+        return;
+    }
+
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+}
+
+// Ensure capacity for the buffered bytes, preserving them. Without a pool the
+// buffer grows geometrically on insert. With a pool it moves to a buffer of
+// at least twice the capacity (up to the block class), so that capacity grows
+// by class, or geometrically between classes, as bytes arrive.
+void stream_decoder::reserve(size_t size)
+{
+    if (pool_ == nullptr || buffer_.capacity() >= size)
+        return;
+
+    const auto doubled = std::min(2 * buffer_.capacity(),
+        buffer_pool::block_capacity);
+
+    auto buffer = pool_->acquire(std::max(size, doubled));
+    buffer.insert(buffer.end(), buffer_.begin(), buffer_.end());
+
+    if (buffer_.capacity() != 0)
+        pool_->release(std::move(buffer_));
+
+    buffer_ = std::move(buffer);
+}
+
+// Clear the buffer, giving it up (to the pool if any) if larger than a small
+// message so that large buffers are not held by idle connections.
+void stream_decoder::recycle()
+{
+    buffer_.clear();
+
+    if (buffer_.capacity() <= buffer_pool::small_capacity)
+        return;
+
+    if (pool_ != nullptr)
+        pool_->release(std::move(buffer_));
+
+    buffer_ = data_chunk();
+}
+
+// The size of the next message part, never zero (empty payloads are
+// dispatched upon consuming the heading).
+size_t stream_decoder::required() const
+{
+    return have_heading_ ? heading_.payload_size() :
+        heading::satoshi_fixed_size();
+}
+
+code stream_decoder::decode(data_slice data, handler handler)
+{
+    auto position = data.begin();
+    const auto end = data.end();
+
+    while (position != end)
+    {
+        const auto size = required();
+        const auto available = static_cast<size_t>(end - position);
+
+        // The part lies within the read, consume it in place.
+        if (buffer_.empty() && available >= size)
+        {
+            const data_slice part(position, position + size);
+            position += size;
+            const auto ec = consume(part, handler);
+
+            if (ec)
+                return ec;
+
+            continue;
+        }
+
+        // Capacity follows the bytes that have arrived, not the payload size
+        // declared by the peer, so a stalled connection cannot hold a large
+        // buffer.
+        const auto count = std::min(size - buffer_.size(), available);
+        reserve(buffer_.size() + count);
+        buffer_.insert(buffer_.end(), position, position + count);
+        position += count;
+
+        if (buffer_.size() < size)
+            break;
+
+        // Clear after dispatch, small buffer capacity is retained for reuse.
+        const auto ec = consume(buffer_, handler);
+        recycle();
+
+        if (ec)
+            return ec;
+    }
+
+    return error::success;
+}
+
+code stream_decoder::consume(data_slice part, handler& handler)
+{
+    if (have_heading_)
+        return dispatch(part, handler);
+
+    auto source = make_safe_deserializer(part.begin(), part.end());
+
+    if (!heading_.from_data(source) || heading_.magic() != magic_ ||
+        heading_.payload_size() > maximum_payload_)
+        return error::bad_stream;
+
+    if (heading_.payload_size() != 0)
+    {
+        have_heading_ = true;
+        return error::success;
+    }
+
+    // There will be no payload part so dispatch the empty payload now.
+    return dispatch({ part.end(), part.end() }, handler);
+}
+
+code stream_decoder::dispatch(data_slice payload, handler& handler)
+{
+    BITCOIN_ASSERT(payload.size() == heading_.payload_size());
+    have_heading_ = false;
+
+    if (bitcoin_checksum(payload) != heading_.checksum())
+        return error::bad_stream;
+
+    return handler(heading_, payload);
+}
+
+} // namespace message
+} // namespace libbitcoin
@@ -22,6 +22,7 @@
 #include <utility>
 #include <bitcoin/bitcoin/chain/input.hpp>
 #include <bitcoin/bitcoin/chain/output.hpp>
+#include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/message/version.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
@@ -58,40 +59,54 @@ transaction transaction::factory(uint32_t version,
 }
 
 transaction::transaction()
-  : chain::transaction()
+  : chain::transaction(),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
 transaction::transaction(transaction&& other)
-  : chain::transaction(std::move(other))
+  : chain::transaction(std::move(other)),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
 transaction::transaction( transaction& other)
-  : chain::transaction(other)
+  : chain::transaction(other),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
 transaction::transaction(chain::transaction&& other)
-  : chain::transaction(std::move(other))
+  : chain::transaction(std::move(other)),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
 transaction::transaction( chain::transaction& other)
-  : chain::transaction(other)
+  : chain::transaction(other),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
 transaction::transaction(uint32_t version, uint32_t locktime,
     chain::input::list&& inputs, chain::output::list&& outputs)
   : chain::transaction(version, locktime, std::move(inputs),
-        std::move(outputs))
+        std::move(outputs)),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
 transaction::transaction(uint32_t version, uint32_t locktime,
     const chain::input::list& inputs, const chain::output::list& outputs)
-  : chain::transaction(version, locktime, inputs, outputs)
+  : chain::transaction(version, locktime, inputs, outputs),
+    wire_revision_(0), wire_version_(0), wire_magic_(0),
+    wire_witness_(false)
 {
 }
 
@@ -136,16 +151,85 @@ size_t transaction::serialized_size(uint32_t) const
     return chain::transaction::serialized_size(true, true);
 }
 
+transaction::wire_ptr transaction::to_wire(uint32_t version, uint32_t magic,
+    bool witness) const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    wire_mutex_.lock_upgrade();
+
+    // Any modification of the transaction advances its revision.
+    const auto revision = chain::transaction::revision();
+
+    if (!wire_ || wire_revision_ != revision || wire_version_ != version ||
+        wire_magic_ != magic || wire_witness_ != witness)
+    {
+        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+        wire_mutex_.unlock_upgrade_and_lock();
+        wire_.reset();
+
+        // The payload is independent of version, witness may be excluded.
+        const auto payload = [this, witness](writer& sink)
+        {
+            chain::transaction::to_data(sink, true, witness);
+        };
+
+        data_chunk data;
+        const auto payload_size = chain::transaction::serialized_size(true,
+            witness);
+
+        if (write_message(data, command, magic, payload_size, payload))
+        {
+            wire_ = std::make_shared<const data_chunk>(std::move(data));
+            wire_revision_ = revision;
+            wire_version_ = version;
+            wire_magic_ = magic;
+            wire_witness_ = witness;
+        }
+
+        wire_mutex_.unlock_and_lock_upgrade();
+        //---------------------------------------------------------------------
+    }
+
+    const auto wire = wire_ ? wire_ : std::make_shared<const data_chunk>();
+    wire_mutex_.unlock_upgrade();
+    ///////////////////////////////////////////////////////////////////////////
+
+    return wire;
+}
+
+// private
+void transaction::invalidate_wire() const
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    wire_mutex_.lock_upgrade();
+
+    if (wire_)
+    {
+        wire_mutex_.unlock_upgrade_and_lock();
+        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+        wire_.reset();
+        //---------------------------------------------------------------------
+        wire_mutex_.unlock_and_lock_upgrade();
+    }
+
+    wire_mutex_.unlock_upgrade();
+    ///////////////////////////////////////////////////////////////////////////
+}
+
 transaction& transaction::operator=(chain::transaction&& other)
 {
     reset();
     chain::transaction::operator=(std::move(other));
+    invalidate_wire();
     return *this;
 }
 
 transaction& transaction::operator=(transaction&& other)
 {
     chain::transaction::operator=(std::move(other));
+    invalidate_wire();
     return *this;
 }
 
@@ -99,6 +99,10 @@ void verack::to_data(uint32_t, std::ostream&) const
 {
 }
 
+void verack::to_data(uint32_t, writer&) const
+{
+}
+
 size_t verack::serialized_size(uint32_t version) const
 {
     return verack::satoshi_fixed_size(version);
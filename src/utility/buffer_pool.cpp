@@ -0,0 +1,185 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/buffer_pool.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+
+// The size of a message heading, which is included in each class.
+static const size_t heading_size = 3 * sizeof(uint32_t) + command_size;
+
+// Small messages (inv, getdata, ping, addr) with up to ~100 entries.
+const size_t buffer_pool::small_capacity = 4096;
+
+// Transactions up to the standard size limit (100,000 bytes).
+const size_t buffer_pool::transaction_capacity = 131072;
+
+// Blocks up to the maximum (witness) message payload.
+const size_t buffer_pool::block_capacity = max_block_weight + heading_size;
+
+// Per class retention limits, bounding retained memory to about 28MB.
+static const size_t small_limit = 1024;
+static const size_t transaction_limit = 64;
+static const size_t block_limit = 4;
+
+double buffer_pool::statistics::hit_rate() const
+{
+    const auto total = hits + misses;
+    return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+}
+
+buffer_pool::buffer_pool()
+  : hits_(0), misses_(0), recycled_(0), discarded_(0)
+{
+    classes_[0].capacity = small_capacity;
+    classes_[0].limit = small_limit;
+    classes_[1].capacity = transaction_capacity;
+    classes_[1].limit = transaction_limit;
+    classes_[2].capacity = block_capacity;
+    classes_[2].limit = block_limit;
+
+    // Reserve the class lists so that recycling never allocates.
+    for (auto& size_class: classes_)
+        size_class.buffers.reserve(size_class.limit);
+}
+
+// The smallest class that can satisfy the size, if any. The block class is
+// used only for sizes over half of its capacity, so that it pins no more than
+// twice the size, smaller sizes are allocated exactly and not retained.
+buffer_pool::size_class* buffer_pool::acquire_class(size_t size)
+{
+    if (size > transaction_capacity && size <= block_capacity / 2)
+        return nullptr;
+
+    for (auto& size_class: classes_)
+        if (size <= size_class.capacity)
+            return &size_class;
+
+    return nullptr;
+}
+
+// The class of exactly the capacity, if any. A larger buffer is not retained
+// in a lower class, as that would exceed the retained memory bound.
+buffer_pool::size_class* buffer_pool::release_class(size_t capacity)
+{
+    for (auto& size_class: classes_)
+        if (capacity == size_class.capacity)
+            return &size_class;
+
+    return nullptr;
+}
+
+data_chunk buffer_pool::acquire(size_t size)
+{
+    data_chunk buffer;
+    const auto pool = acquire_class(size);
+
+    if (pool != nullptr)
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        unique_lock lock(pool->mutex);
+
+        if (!pool->buffers.empty())
+        {
+            buffer = std::move(pool->buffers.back());
+            pool->buffers.pop_back();
+        }
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    if (buffer.capacity() != 0)
+    {
+        ++hits_;
+        return buffer;
+    }
+
+    // Allocate to the class capacity so that the buffer can be recycled.
+    ++misses_;
+    buffer.reserve(pool == nullptr ? size : pool->capacity);
+    return buffer;
+}
+
+void buffer_pool::release(data_chunk&& buffer)
+{
+    const auto pool = release_class(buffer.capacity());
+
+    if (pool != nullptr)
+    {
+        buffer.clear();
+
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        unique_lock lock(pool->mutex);
+
+        if (pool->buffers.size() < pool->limit)
+        {
+            pool->buffers.push_back(std::move(buffer));
+            ++recycled_;
+            return;
+        }
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    // Free the buffer now, as the caller's reference may be long lived.
+    ++discarded_;
+    data_chunk discard(std::move(buffer));
+}
+
+void buffer_pool::clear()
+{
+    for (auto& size_class: classes_)
+    {
+        std::vector<data_chunk> buffers;
+        buffers.reserve(size_class.limit);
+
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        unique_lock lock(size_class.mutex);
+        size_class.buffers.swap(buffers);
+        ///////////////////////////////////////////////////////////////////////
+    }
+}
+
+buffer_pool::statistics buffer_pool::stats() const
+{
+    statistics out{ hits_, misses_, recycled_, discarded_, 0, 0 };
+
+    for (const auto& size_class: classes_)
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        shared_lock lock(size_class.mutex);
+        out.retained += size_class.buffers.size();
+
+        for (const auto& buffer: size_class.buffers)
+            out.retained_bytes += buffer.capacity();
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    return out;
+}
+
+} // namespace libbitcoin
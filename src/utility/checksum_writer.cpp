@@ -0,0 +1,271 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/checksum_writer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/limits.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include "../math/external/sha256.h"
+
+namespace libbitcoin {
+
+static_assert(sizeof(SHA256CTX) <= 104, "checksum_writer context too small");
+static_assert(alignof(SHA256CTX) <= sizeof(uint32_t),
+    "checksum_writer context misaligned");
+
+static SHA256CTX& to_context(void* storage)
+{
+    return *static_cast<SHA256CTX*>(storage);
+}
+
+checksum_writer::checksum_writer(uint8_t* begin, uint8_t* end)
+  : valid_(true), begin_(begin), end_(end), position_(begin),
+    chunk_(nullptr), start_(0), limit_(0)
+{
+    SHA256Init(new (&context_) SHA256CTX);
+}
+
+checksum_writer::checksum_writer(data_chunk& chunk, size_t size)
+  : valid_(true), begin_(nullptr), end_(nullptr), position_(nullptr),
+    chunk_(&chunk), start_(chunk.size()), limit_(ceiling_add(start_, size))
+{
+    SHA256Init(new (&context_) SHA256CTX);
+}
+
+// Context.
+//-----------------------------------------------------------------------------
+
+checksum_writer::operator bool() const
+{
+    return valid_;
+}
+
+bool checksum_writer::operator!() const
+{
+    return !valid_;
+}
+
+// Hashes.
+//-----------------------------------------------------------------------------
+
+void checksum_writer::write_hash(const hash_digest& value)
+{
+    write_bytes(value.data(), value.size());
+}
+
+void checksum_writer::write_short_hash(const short_hash& value)
+{
+    write_bytes(value.data(), value.size());
+}
+
+void checksum_writer::write_mini_hash(const mini_hash& value)
+{
+    write_bytes(value.data(), value.size());
+}
+
+// Big Endian Integers.
+//-----------------------------------------------------------------------------
+
+void checksum_writer::write_2_bytes_big_endian(uint16_t value)
+{
+    write_bytes(to_big_endian(value));
+}
+
+void checksum_writer::write_4_bytes_big_endian(uint32_t value)
+{
+    write_bytes(to_big_endian(value));
+}
+
+void checksum_writer::write_8_bytes_big_endian(uint64_t value)
+{
+    write_bytes(to_big_endian(value));
+}
+
+void checksum_writer::write_variable_big_endian(uint64_t value)
+{
+    if (value < varint_two_bytes)
+    {
+        write_byte(static_cast<uint8_t>(value));
+    }
+    else if (value <= max_uint16)
+    {
+        write_byte(varint_two_bytes);
+        write_2_bytes_big_endian(static_cast<uint16_t>(value));
+    }
+    else if (value <= max_uint32)
+    {
+        write_byte(varint_four_bytes);
+        write_4_bytes_big_endian(static_cast<uint32_t>(value));
+    }
+    else
+    {
+        write_byte(varint_eight_bytes);
+        write_8_bytes_big_endian(value);
+    }
+}
+
+void checksum_writer::write_size_big_endian(size_t value)
+{
+    write_variable_big_endian(value);
+}
+
+// Little Endian Integers.
+//-----------------------------------------------------------------------------
+
+void checksum_writer::write_2_bytes_little_endian(uint16_t value)
+{
+    write_bytes(to_little_endian(value));
+}
+
+void checksum_writer::write_4_bytes_little_endian(uint32_t value)
+{
+    write_bytes(to_little_endian(value));
+}
+
+void checksum_writer::write_8_bytes_little_endian(uint64_t value)
+{
+    write_bytes(to_little_endian(value));
+}
+
+void checksum_writer::write_variable_little_endian(uint64_t value)
+{
+    if (value < varint_two_bytes)
+    {
+        write_byte(static_cast<uint8_t>(value));
+    }
+    else if (value <= max_uint16)
+    {
+        write_byte(varint_two_bytes);
+        write_2_bytes_little_endian(static_cast<uint16_t>(value));
+    }
+    else if (value <= max_uint32)
+    {
+        write_byte(varint_four_bytes);
+        write_4_bytes_little_endian(static_cast<uint32_t>(value));
+    }
+    else
+    {
+        write_byte(varint_eight_bytes);
+        write_8_bytes_little_endian(value);
+    }
+}
+
+void checksum_writer::write_size_little_endian(size_t value)
+{
+    write_variable_little_endian(value);
+}
+
+// Bytes.
+//-----------------------------------------------------------------------------
+
+void checksum_writer::write_byte(uint8_t value)
+{
+    write_bytes(&value, 1);
+}
+
+void checksum_writer::write_bytes(const data_slice data)
+{
+    write_bytes(data.data(), data.size());
+}
+
+// All writes funnel through here, hashing the bytes while they are hot.
+void checksum_writer::write_bytes(const uint8_t* data, size_t size)
+{
+    if (!valid_ || size > remaining())
+    {
+        valid_ = false;
+        return;
+    }
+
+    SHA256Update(&to_context(&context_), data, size);
+
+    if (chunk_ == nullptr)
+        position_ = std::copy_n(data, size, position_);
+    else
+        chunk_->insert(chunk_->end(), data, data + size);
+}
+
+void checksum_writer::write_string(const std::string& value, size_t size)
+{
+    const auto length = std::min(size, value.size());
+    write_bytes(reinterpret_cast<const uint8_t*>(value.data()), length);
+
+    // Pad in place rather than from a temporary buffer.
+    for (auto pad = length; pad < size; ++pad)
+        write_byte(string_terminator);
+}
+
+void checksum_writer::write_string(const std::string& value)
+{
+    write_variable_little_endian(value.size());
+    write_bytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+}
+
+void checksum_writer::skip(size_t size)
+{
+    if (!valid_ || size > remaining())
+    {
+        valid_ = false;
+        return;
+    }
+
+    if (chunk_ == nullptr)
+    {
+        SHA256Update(&to_context(&context_), position_, size);
+        position_ += size;
+        return;
+    }
+
+    // Skipped bytes do not exist when appending, so they are appended as zero.
+    const auto offset = chunk_->size();
+    chunk_->resize(offset + size);
+    SHA256Update(&to_context(&context_), chunk_->data() + offset, size);
+}
+
+// non-interface
+//-----------------------------------------------------------------------------
+
+size_t checksum_writer::size() const
+{
+    return chunk_ == nullptr ? static_cast<size_t>(position_ - begin_) :
+        chunk_->size() - start_;
+}
+
+// private
+size_t checksum_writer::remaining() const
+{
+    return chunk_ == nullptr ? static_cast<size_t>(end_ - position_) :
+        limit_ - chunk_->size();
+}
+
+uint32_t checksum_writer::checksum()
+{
+    hash_digest hash;
+    SHA256Final(&to_context(&context_), hash.data());
+    hash = sha256_hash(hash);
+    return from_little_endian_unsafe<uint32_t>(hash.begin());
+}
+
+} // namespace libbitcoin
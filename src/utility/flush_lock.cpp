@@ -61,23 +61,18 @@ bool flush_lock::try_lock()
 
 bool flush_lock::lock_shared()
 {
-    const auto this_id = boost::this_thread::get_id();
-
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " flush_lock::lock_shared() was called.";
 
     if (locked_)
     {
-        LOG_VERBOSE(LOG_SYSTEM)
-        << this_id
+        LOG_TRACE(LOG_SYSTEM)
         << " flush_lock::lock_shared() locked_ already true.";
 
         return true;
     }
 
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " flush_lock::lock_shared() calling create() for file: "
     << file_;
 
@@ -86,13 +81,12 @@ bool flush_lock::lock_shared()
     if (!locked_)
     {
         LOG_VERBOSE(LOG_SYSTEM)
-        << this_id
+        << boost::this_thread::get_id()
         << " error flush_lock::lock_shared() failed to create() file: "
         << file_;
     }
 
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " flush_lock::lock_shared() done. returning...";
 
     return locked_;
@@ -214,6 +214,12 @@ data_chunk istream_reader::read_bytes(size_t size)
     return out;
 }
 
+void istream_reader::read_bytes(uint8_t* buffer, size_t size)
+{
+    if (size > 0)
+        stream_.read(reinterpret_cast<char*>(buffer), size);
+}
+
 std::string istream_reader::read_string()
 {
     return read_string(read_size_little_endian());
@@ -18,6 +18,13 @@
  */
 #include <bitcoin/bitcoin/utility/threadpool.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <bitcoin/bitcoin.hpp>
 #include <bitcoin/bitcoin/error.hpp>
@@ -32,9 +39,7 @@ threadpool::threadpool(size_t number_threads, thread_priority priority)
   : size_(0)
 {
     shutdown_ = false;
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " threadpool(" << number_threads << " threads)"
     << "with io_context service at: " << &service_;
     spawn(number_threads, priority);
@@ -42,9 +47,7 @@ threadpool::threadpool(size_t number_threads, thread_priority priority)
 
 threadpool::~threadpool()
 {
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " ~threadpool()";
     shutdown();
     join();
@@ -53,9 +56,7 @@ threadpool::~threadpool()
 // Should not be called during spawn.
 bool threadpool::empty() const
 {
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " threadpool::empty()";
     return size() != 0;
 }
@@ -63,9 +64,7 @@ bool threadpool::empty() const
 // Should not be called during spawn.
 size_t threadpool::size() const
 {
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " threadpool::size()";
     return size_.load();
 }
@@ -73,9 +72,7 @@ size_t threadpool::size() const
 // This is not thread safe.
 void threadpool::spawn(size_t number_threads, thread_priority priority)
 {
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " threadpool::spawn(" << number_threads << " threads)"
     << " with io_context service at: " << &service_;
     // This allows the pool to be restarted.
@@ -93,9 +90,7 @@ void threadpool::spawn_once(thread_priority priority)
     unique_lock lockdown(shutdown_mutex_);
     if (!shutdown_)
     {
-        const auto this_id = boost::this_thread::get_id();
-        LOG_VERBOSE(LOG_SYSTEM)
-        << this_id
+        LOG_TRACE(LOG_SYSTEM)
         << " threadpool::spawn_once()";
         ///////////////////////////////////////////////////////////////////////////
         // Critical Section
@@ -133,9 +128,7 @@ void threadpool::spawn_once(thread_priority priority)
 
 void threadpool::abort()
 {
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " threadpool::abort()";
     service_.stop();
 }
@@ -147,9 +140,7 @@ void threadpool::shutdown()
     unique_lock lockdown(shutdown_mutex_);
 
     shutdown_ = true;
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " threadpool::shutdown()";
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
@@ -165,9 +156,7 @@ void threadpool::join()
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
     unique_lock lockdown(shutdown_mutex_);
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " threadpool::join()";
     ///////////////////////////////////////////////////////////////////////////
     // Critical Section
@@ -190,20 +179,72 @@ void threadpool::join()
 
 asio::service& threadpool::service()
 {
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " threadpool::service()";
     return service_;
 }
 
 const asio::service& threadpool::service() const
 {
-    const auto this_id = boost::this_thread::get_id();
-    LOG_VERBOSE(LOG_SYSTEM)
-    << this_id
+    LOG_TRACE(LOG_SYSTEM)
     << " const threadpool::service() const";
     return service_;
 }
 
+// Shared state of a batch of indexed jobs, outlives the posting call.
+struct job_batch
+{
+    job_batch(size_t count, std::function<void(size_t)> job)
+      : count(count), job(job), next(0), done(0)
+    {
+    }
+
+    const size_t count;
+    const std::function<void(size_t)> job;
+    std::atomic<size_t> next;
+    std::atomic<size_t> done;
+    std::mutex mutex;
+    std::condition_variable completed;
+};
+
+// Claim and run jobs until none remain. A late helper claims nothing.
+static void drain(std::shared_ptr<job_batch> batch)
+{
+    size_t index;
+
+    while ((index = batch->next++) < batch->count)
+    {
+        batch->job(index);
+
+        if (++batch->done == batch->count)
+        {
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            batch->completed.notify_all();
+        }
+    }
+}
+
+// The calling thread also drains the batch, so this makes progress even if
+// called from a pool thread or if the pool has no threads.
+void parallel_for(threadpool& pool, size_t count,
+    std::function<void(size_t)> job)
+{
+    if (count == 0)
+        return;
+
+    const auto batch = std::make_shared<job_batch>(count, job);
+    const auto helpers = std::min(pool.size(), count - 1);
+
+    for (size_t helper = 0; helper < helpers; ++helper)
+        pool.service().post(std::bind(drain, batch));
+
+    drain(batch);
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->completed.wait(lock, [&batch]()
+    {
+        return batch->done == batch->count;
+    });
+}
+
 } // namespace libbitcoin
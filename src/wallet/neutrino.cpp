@@ -0,0 +1,184 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/wallet/neutrino.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/script.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/machine/opcode.hpp>
+#include <bitcoin/bitcoin/math/golomb_coding.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/siphash.hpp>
+#include <bitcoin/bitcoin/message/messages.hpp>
+#include <bitcoin/bitcoin/utility/container_sink.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
+#include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+
+namespace libbitcoin {
+namespace wallet {
+
+using namespace bc::chain;
+using namespace bc::machine;
+
+// The filter key is the first half of the block hash.
+static siphash_key to_filter_key(const hash_digest& block_hash)
+{
+    return to_siphash_key(slice<0, half_hash_size>(block_hash));
+}
+
+static bool is_filtered_output(data_slice script)
+{
+    return script.empty() ||
+        *script.begin() == static_cast<uint8_t>(opcode::return_);
+}
+
+static bool slice_less(data_slice left, data_slice right)
+{
+    return std::lexicographical_compare(left.begin(), left.end(),
+        right.begin(), right.end());
+}
+
+static bool slice_equal(data_slice left, data_slice right)
+{
+    return left.size() == right.size() &&
+        std::equal(left.begin(), left.end(), right.begin());
+}
+
+// The encoded size of a variable integer, from its first byte.
+static size_t variable_size(uint8_t prefix)
+{
+    switch (prefix)
+    {
+        case varint_two_bytes:
+            return sizeof(uint8_t) + sizeof(uint16_t);
+        case varint_four_bytes:
+            return sizeof(uint8_t) + sizeof(uint32_t);
+        case varint_eight_bytes:
+            return sizeof(uint8_t) + sizeof(uint64_t);
+        default:
+            return sizeof(uint8_t);
+    }
+}
+
+// Parse the element count prefix, setting the coded set.
+static bool parse_filter(uint64_t& out_count, data_slice& out_set,
+    data_slice filter)
+{
+    auto source = make_safe_deserializer(filter.begin(), filter.end());
+    out_count = source.read_variable_little_endian();
+
+    if (!source)
+        return false;
+
+    // The set follows the count as encoded. A non-minimal count is rejected
+    // as non-canonical (bip158 CompactSize), as its set would be misaligned.
+    const auto size = variable_size(*filter.begin());
+
+    if (size != message::variable_uint_size(out_count))
+        return false;
+
+    out_set = { filter.data() + size, filter.data() + filter.size() };
+    return true;
+}
+
+bool compute_filter(block& block, data_chunk& out_filter)
+{
+    std::vector<data_slice> items;
+
+    // Scripts are referenced in place, not copied.
+    for (const auto& tx: block.transactions())
+    {
+        for (const auto& output: tx.outputs())
+        {
+            const auto script = output.script().bytes();
+            if (!is_filtered_output(script))
+                items.push_back(script);
+        }
+
+        if (tx.is_coinbase())
+            continue;
+
+        for (const auto& input: tx.inputs())
+        {
+            const auto& prevout = input.previous_output().metadata.cache;
+            if (!prevout.is_valid())
+                return false;
+
+            const auto script = prevout.script().bytes();
+            if (!script.empty())
+                items.push_back(script);
+        }
+    }
+
+    std::sort(items.begin(), items.end(), slice_less);
+    items.erase(std::unique(items.begin(), items.end(), slice_equal),
+        items.end());
+
+    const auto set = golomb_construct(items, neutrino_filter_bits,
+        to_filter_key(block.hash()), neutrino_filter_rate);
+
+    out_filter.clear();
+    out_filter.reserve(message::variable_uint_size(items.size()) + set.size());
+    data_sink ostream(out_filter);
+    ostream_writer sink(ostream);
+    sink.write_variable_little_endian(items.size());
+    sink.write_bytes(set);
+    ostream.flush();
+    return true;
+}
+
+hash_digest compute_filter_header(const hash_digest& previous_header,
+    data_slice filter)
+{
+    return bitcoin_hash({ bitcoin_hash(filter), previous_header });
+}
+
+bool match_filter(const hash_digest& block_hash, data_slice filter,
+    const script& script)
+{
+    uint64_t count;
+    data_slice set = filter;
+
+    if (!parse_filter(count, set, filter))
+        return false;
+
+    return golomb_match(script.bytes(), set, count, neutrino_filter_bits,
+        to_filter_key(block_hash), neutrino_filter_rate);
+}
+
+bool match_filter(const hash_digest& block_hash, data_slice filter,
+    const data_stack& scripts)
+{
+    uint64_t count;
+    data_slice set = filter;
+
+    if (!parse_filter(count, set, filter))
+        return false;
+
+    const std::vector<data_slice> targets(scripts.begin(), scripts.end());
+    return golomb_match(targets, set, count, neutrino_filter_bits,
+        to_filter_key(block_hash), neutrino_filter_rate);
+}
+
+} // namespace wallet
+} // namespace libbitcoin
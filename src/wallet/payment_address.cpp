@@ -306,7 +306,9 @@ payment_address::list payment_address::extract_input(
 payment_address::list payment_address::extract_output(
     const chain::script& script, uint8_t p2kh_version, uint8_t p2sh_version)
 {
+    // The pattern and its payload are cached, operations are not parsed.
     const auto pattern = script.output_pattern();
+    const auto payload = script.output_payload();
 
     switch (pattern)
     {
@@ -314,14 +316,14 @@ payment_address::list payment_address::extract_output(
         {
             return
             {
-                { to_array<short_hash_size>(script[2].data()), p2kh_version }
+                { to_array<short_hash_size>(payload), p2kh_version }
             };
         }
         case script_pattern::pay_script_hash:
         {
             return
             {
-                { to_array<short_hash_size>(script[1].data()), p2sh_version }
+                { to_array<short_hash_size>(payload), p2sh_version }
             };
         }
         case script_pattern::pay_public_key:
@@ -329,7 +331,7 @@ payment_address::list payment_address::extract_output(
             return
             {
                 // pay_public_key is not p2kh but we conflate for tracking.
-                { ec_public{ script[0].data() }, p2kh_version }
+                { ec_public{ to_chunk(payload) }, p2kh_version }
             };
         }
 
@@ -312,6 +312,30 @@ BOOST_AUTO_TEST_CASE(block__factory_1__genesis_mainnet__success)
     BOOST_REQUIRE(genesis.header().merkle() == block.generate_merkle_root());
 }
 
+BOOST_AUTO_TEST_CASE(block__serialized_size__set_transactions__invalidates_cache)
+{
+    const chain::block genesis = settings(bc::config::settings::mainnet).genesis_block;
+    auto block = chain::block::factory(genesis.to_data());
+    BOOST_REQUIRE_EQUAL(block.serialized_size(false), 285u);
+    BOOST_REQUIRE_EQUAL(block.serialized_size(true), 285u);
+    BOOST_REQUIRE_EQUAL(block.weight(), 4u * 285u);
+
+    block.set_transactions(chain::transaction::list{});
+    BOOST_REQUIRE_EQUAL(block.serialized_size(false), 81u);
+    BOOST_REQUIRE_EQUAL(block.serialized_size(true), 81u);
+}
+
+BOOST_AUTO_TEST_CASE(block__serialized_size__mutable_transactions__invalidates_cache)
+{
+    const chain::block genesis = settings(bc::config::settings::mainnet).genesis_block;
+    auto block = chain::block::factory(genesis.to_data());
+    BOOST_REQUIRE_EQUAL(block.serialized_size(false), 285u);
+
+    block.transactions().clear();
+    BOOST_REQUIRE_EQUAL(block.serialized_size(false), 81u);
+    BOOST_REQUIRE_EQUAL(block.serialized_size(true), 81u);
+}
+
 BOOST_AUTO_TEST_CASE(block__factory_2__genesis_mainnet__success)
 {
     const chain::block genesis = settings(bc::config::settings::mainnet).genesis_block;
@@ -714,4 +738,75 @@ BOOST_AUTO_TEST_CASE(block__is_forward_reference__forward_reference__true)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(block_check_tests)
+
+BOOST_AUTO_TEST_CASE(block__check__genesis_mainnet_threadpool__matches_serial)
+{
+    const settings configuration(bc::config::settings::mainnet);
+    chain::block genesis = configuration.genesis_block;
+    threadpool pool(2);
+
+    const auto serial = genesis.check(configuration.max_money(),
+        configuration.timestamp_limit_seconds,
+        configuration.proof_of_work_limit);
+    const auto parallel = genesis.check(configuration.max_money(),
+        configuration.timestamp_limit_seconds,
+        configuration.proof_of_work_limit, pool);
+
+    pool.shutdown();
+    pool.join();
+    BOOST_REQUIRE_EQUAL(serial, error::success);
+    BOOST_REQUIRE_EQUAL(parallel, serial);
+}
+
+BOOST_AUTO_TEST_CASE(block__check__threadpool_extra_coinbases__structural_error)
+{
+    const settings configuration(bc::config::settings::mainnet);
+    chain::block instance = configuration.genesis_block;
+    const auto coinbase = instance.transactions().front();
+    instance.set_transactions({ coinbase, coinbase });
+    threadpool pool(2);
+
+    const auto parallel = instance.check(configuration.max_money(),
+        configuration.timestamp_limit_seconds,
+        configuration.proof_of_work_limit, pool);
+
+    pool.shutdown();
+    pool.join();
+    BOOST_REQUIRE_EQUAL(parallel, error::extra_coinbases);
+    BOOST_REQUIRE_EQUAL(instance.check(configuration.max_money(),
+        configuration.timestamp_limit_seconds,
+        configuration.proof_of_work_limit), parallel);
+}
+
+BOOST_AUTO_TEST_CASE(block__check_transactions__threadpool_multiple_failures__first_error)
+{
+    static const uint64_t max_money = 100;
+    const auto hash = hash_literal("0000000000000000000000000000000000000000000000000000000000000001");
+    const chain::transaction valid{ 1, 0, { { { hash, 0 }, {}, 0 } }, { { max_money, {} } } };
+    const chain::transaction overflow{ 1, 0, { { { hash, 1 }, {}, 0 } }, { { max_money + 1, {} } } };
+    const chain::transaction empty{ 1, 0, {}, {} };
+
+    chain::block instance;
+    instance.set_transactions({ valid, valid, overflow, valid, empty });
+    threadpool pool(4);
+
+    const auto parallel = instance.check_transactions(max_money, pool);
+    pool.shutdown();
+    pool.join();
+    BOOST_REQUIRE_EQUAL(parallel, error::spend_overflow);
+    BOOST_REQUIRE_EQUAL(instance.check_transactions(max_money), parallel);
+}
+
+BOOST_AUTO_TEST_CASE(block__check_transactions__empty_threadpool__runs_on_caller)
+{
+    const chain::transaction empty{ 1, 0, {}, {} };
+    chain::block instance;
+    instance.set_transactions({ empty });
+    threadpool pool;
+    BOOST_REQUIRE_EQUAL(instance.check_transactions(0, pool), error::empty_transaction);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(chain_block_view_tests)
+
+static const auto genesis_hash = hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+static const auto genesis_merkle = hash_literal("4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b");
+
+BOOST_AUTO_TEST_CASE(block_view__constructor_1__always__invalid)
+{
+    chain::block_view instance;
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.transactions_size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(block_view__from_data__genesis_mainnet__expected)
+{
+    const chain::block genesis = settings(bc::config::settings::mainnet).genesis_block;
+    const auto raw_block = genesis.to_data();
+    const chain::block_view instance(raw_block);
+
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(), 285u);
+    BOOST_REQUIRE(instance.hash() == genesis_hash);
+    BOOST_REQUIRE(instance.header().merkle() == genesis_merkle);
+    BOOST_REQUIRE_EQUAL(instance.transactions_size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(block_view__to_hashes__genesis_mainnet__merkle_root)
+{
+    const chain::block genesis = settings(bc::config::settings::mainnet).genesis_block;
+    const auto raw_block = genesis.to_data();
+    const chain::block_view instance(raw_block);
+    const auto hashes = instance.to_hashes();
+
+    BOOST_REQUIRE_EQUAL(hashes.size(), 1u);
+    BOOST_REQUIRE(hashes.front() == genesis_merkle);
+}
+
+BOOST_AUTO_TEST_CASE(block_view__transaction__genesis_mainnet__coinbase_output_in_place)
+{
+    const chain::block genesis = settings(bc::config::settings::mainnet).genesis_block;
+    const auto raw_block = genesis.to_data();
+    const chain::block_view instance(raw_block);
+    const auto tx = instance.transaction(0);
+
+    BOOST_REQUIRE(tx.is_valid());
+    BOOST_REQUIRE_EQUAL(tx.inputs_size(), 1u);
+    BOOST_REQUIRE_EQUAL(tx.outputs_size(), 1u);
+    BOOST_REQUIRE_EQUAL(tx.output_value(0), 5000000000u);
+    BOOST_REQUIRE_EQUAL(tx.output_script(0).size(), 67u);
+}
+
+BOOST_AUTO_TEST_CASE(block_view__to_block__genesis_mainnet__equals_original)
+{
+    const chain::block genesis = settings(bc::config::settings::mainnet).genesis_block;
+    const auto raw_block = genesis.to_data();
+    const chain::block_view instance(raw_block);
+    BOOST_REQUIRE(instance.to_block() == genesis);
+}
+
+BOOST_AUTO_TEST_CASE(block_view__from_data__truncated__invalid)
+{
+    const chain::block genesis = settings(bc::config::settings::mainnet).genesis_block;
+    auto raw_block = genesis.to_data();
+    raw_block.pop_back();
+    const chain::block_view instance(raw_block);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(block_view__from_data__trailing_bytes__invalid)
+{
+    const chain::block genesis = settings(bc::config::settings::mainnet).genesis_block;
+    auto raw_block = genesis.to_data();
+    raw_block.push_back(0x00);
+    const chain::block_view instance(raw_block);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
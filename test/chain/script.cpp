@@ -130,6 +130,87 @@ std::string test_name(const script_test& test)
     return out.str();
 }
 
+// Differential helpers (standard templates versus evaluation).
+//------------------------------------------------------------------------------
+
+static const auto standard_forks = rule_fork::all_rules;
+static const uint64_t standard_value = 100000;
+
+static const ec_secret standard_secret1 = base16_literal(
+    "ce8f4b713ffdd2658900845251890f30371856be201cd1f5b3d970f793634333");
+static const ec_secret standard_secret2 = base16_literal(
+    "8a6ae8d2d6fd47b8c5bb5b7a6b12d4d4b2ac2b5a6e9d0ab9cb9e19f45d8e3c11");
+static const ec_secret standard_secret3 = base16_literal(
+    "1b9c3f1e7d8a2e4f6b0c9d8e7f6a5b4c3d2e1f0a9b8c7d6e5f4a3b2c1d0e9f8a");
+
+data_chunk to_public_key(const ec_secret& secret)
+{
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+    return to_chunk(point);
+}
+
+// One input spending the prevout, one output (signature scripts excluded).
+transaction new_spend(const script& prevout_script, const script& input_script,
+    const data_stack& stack)
+{
+    output_point outpoint{ null_hash, 0 };
+    outpoint.metadata.cache.set_script(script(prevout_script));
+    outpoint.metadata.cache.set_value(standard_value);
+
+    return transaction
+    {
+        1,
+        0,
+        input::list
+        {
+            input
+            {
+                std::move(outpoint),
+                script(input_script),
+                witness(stack),
+                max_input_sequence
+            }
+        },
+        output::list
+        {
+            output
+            {
+                standard_value - 1000,
+                script(script::to_pay_key_hash_pattern(null_short_hash))
+            }
+        }
+    };
+}
+
+endorsement new_endorsement(const ec_secret& secret, const script& script_code,
+    script_version version, uint8_t sighash_type=sighash_algorithm::all)
+{
+    endorsement out;
+    const auto tx = new_spend(script_code, {}, {});
+    BOOST_REQUIRE(script::create_endorsement(out, secret, script_code, tx, 0,
+        sighash_type, version, standard_value));
+    return out;
+}
+
+// The fast path may only succeed where evaluation succeeds, and the combined
+// result must always be the evaluation result.
+void require_differential(const transaction& tx, uint32_t forks)
+{
+    const auto& prevout = tx.inputs()[0].previous_output().metadata.cache;
+    const auto& prevout_script = prevout.script();
+    const auto value = prevout.value();
+
+    const auto evaluated = script::verify_program(tx, 0, forks, prevout_script,
+        value);
+    const auto standard = script::verify_standard(tx, 0, forks,
+        prevout_script, value);
+
+    BOOST_REQUIRE(!standard || evaluated.value() == error::success);
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, forks).value(),
+        evaluated.value());
+}
+
 BOOST_AUTO_TEST_SUITE(script_tests)
 
 // Serialization tests.
@@ -408,6 +489,254 @@ BOOST_AUTO_TEST_CASE(script__pattern__17_of_17_multisig__non_standard)
     BOOST_REQUIRE(instance.pattern() == machine::script_pattern::non_standard);
 }
 
+// classification
+
+BOOST_AUTO_TEST_CASE(script__classify__pattern_scripts__matches_operation_predicates)
+{
+    static const std::vector<std::string> mnemonics
+    {
+        SCRIPT_RETURN,
+        SCRIPT_RETURN_EMPTY,
+        SCRIPT_RETURN_80,
+        SCRIPT_RETURN_81,
+        SCRIPT_0_OF_3_MULTISIG,
+        SCRIPT_2_OF_3_MULTISIG,
+        SCRIPT_4_OF_3_MULTISIG,
+        SCRIPT_16_OF_16_MULTISIG,
+        SCRIPT_17_OF_17_MULTISIG,
+        "dup hash160 [0000000000000000000000000000000000000000] equalverify checksig",
+        "hash160 [0000000000000000000000000000000000000000] equal",
+        "[03dcfd9e580de35d8c2060d76dbf9e5561fe20febd2e64380e860a4d59f15ac864] checksig",
+        "0 [0000000000000000000000000000000000000000]",
+        "1 [00000000000000000000000000000000000000000000000000000000000000000000]",
+        "[3006020101020101] [03dcfd9e580de35d8c2060d76dbf9e5561fe20febd2e64380e860a4d59f15ac864]",
+        "[3006020101020101]",
+        "0 [3006020101020101] [3006020101020101]",
+        "[42] 1 [43]",
+        "[42] 0",
+        ""
+    };
+
+    for (const auto& mnemonic: mnemonics)
+    {
+        script instance;
+        BOOST_REQUIRE(instance.from_string(mnemonic));
+        const auto bytes = instance.to_data(false);
+        const auto& ops = instance.operations();
+
+        auto output = machine::script_pattern::non_standard;
+        if (script::is_pay_key_hash_pattern(ops))
+            output = machine::script_pattern::pay_key_hash;
+        else if (script::is_pay_script_hash_pattern(ops))
+            output = machine::script_pattern::pay_script_hash;
+        else if (script::is_pay_null_data_pattern(ops))
+            output = machine::script_pattern::pay_null_data;
+        else if (script::is_pay_public_key_pattern(ops))
+            output = machine::script_pattern::pay_public_key;
+        else if (script::is_pay_multisig_pattern(ops))
+            output = machine::script_pattern::pay_multisig;
+
+        auto input = machine::script_pattern::non_standard;
+        if (script::is_sign_key_hash_pattern(ops))
+            input = machine::script_pattern::sign_key_hash;
+        else if (script::is_sign_script_hash_pattern(ops))
+            input = machine::script_pattern::sign_script_hash;
+        else if (script::is_sign_public_key_pattern(ops))
+            input = machine::script_pattern::sign_public_key;
+        else if (script::is_sign_multisig_pattern(ops))
+            input = machine::script_pattern::sign_multisig;
+
+        BOOST_REQUIRE_MESSAGE(script::classify_output(bytes) == output, mnemonic);
+        BOOST_REQUIRE_MESSAGE(script::classify_input(bytes) == input, mnemonic);
+        BOOST_REQUIRE_MESSAGE(instance.output_pattern() == output, mnemonic);
+        BOOST_REQUIRE_MESSAGE(instance.input_pattern() == input, mnemonic);
+        BOOST_REQUIRE_MESSAGE(script::classify_version(bytes) ==
+            instance.version(), mnemonic);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(script__classify_output__non_minimal_null_data__non_standard)
+{
+    // return [pushdata1 01 42] is not a minimal push.
+    BOOST_REQUIRE(script::classify_output(data_chunk{ 0x6a, 0x4c, 0x01, 0x42 }) ==
+        machine::script_pattern::non_standard);
+    BOOST_REQUIRE(script::classify_output(data_chunk{ 0x6a, 0x01, 0x42 }) ==
+        machine::script_pattern::pay_null_data);
+}
+
+BOOST_AUTO_TEST_CASE(script__classify_output__truncated_push__non_standard)
+{
+    BOOST_REQUIRE(script::classify_output(data_chunk{ 0x6a, 0x02, 0x42 }) ==
+        machine::script_pattern::non_standard);
+    BOOST_REQUIRE(script::classify_input(data_chunk{ 0x01, 0x42, 0x02 }) ==
+        machine::script_pattern::non_standard);
+}
+
+BOOST_AUTO_TEST_CASE(script__output_payload__pay_key_hash__hash)
+{
+    const auto hash = base16_literal("0102030405060708090a0b0c0d0e0f1011121314");
+    const script instance(script::to_pay_key_hash_pattern(hash));
+    BOOST_REQUIRE(to_chunk(instance.output_payload()) == to_chunk(hash));
+}
+
+BOOST_AUTO_TEST_CASE(script__output_payload__witness_program__program)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_string("0 [0102030405060708090a0b0c0d0e0f1011121314]"));
+    BOOST_REQUIRE(instance.version() == machine::script_version::zero);
+    BOOST_REQUIRE_EQUAL(encode_base16(instance.output_payload()), "0102030405060708090a0b0c0d0e0f1011121314");
+    BOOST_REQUIRE(instance.witness_program() == to_chunk(instance.output_payload()));
+}
+
+BOOST_AUTO_TEST_CASE(script__output_payload__multisig__empty)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_string(SCRIPT_2_OF_3_MULTISIG));
+    BOOST_REQUIRE(instance.output_payload().empty());
+}
+
+BOOST_AUTO_TEST_CASE(script__operations__truncated_push__invalid_last_operation)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_data(data_chunk{ 0xac, 0x4d, 0x01 }, false));
+    BOOST_REQUIRE_EQUAL(instance.operations().size(), 2u);
+    BOOST_REQUIRE(instance.operations().front().is_valid());
+    BOOST_REQUIRE(!instance.operations().back().is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(script__operations__sized_pushes__expected_count)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_data(data_chunk{ 0x01, 0x42, 0x4c, 0x01, 0x42, 0x4d, 0x00, 0x00, 0xac }, false));
+    BOOST_REQUIRE_EQUAL(instance.operations().size(), 4u);
+    BOOST_REQUIRE(instance.is_valid_operations());
+}
+
+BOOST_AUTO_TEST_CASE(script__tokens__pay_key_hash__payload_in_place)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_string("dup hash160 [0000000000000000000000000000000000000042] equalverify checksig"));
+    const auto& tokens = instance.tokens();
+    BOOST_REQUIRE_EQUAL(tokens.size(), 5u);
+    BOOST_REQUIRE(tokens[0].code == machine::opcode::dup);
+    BOOST_REQUIRE(tokens[2].code == machine::opcode::push_size_20);
+    BOOST_REQUIRE_EQUAL(tokens[2].offset, 3u);
+    BOOST_REQUIRE_EQUAL(tokens[2].size, 20u);
+    BOOST_REQUIRE(tokens[4].valid);
+
+    const auto payload = instance.payload(tokens[2]);
+    BOOST_REQUIRE_EQUAL(payload.size(), 20u);
+    BOOST_REQUIRE_EQUAL(payload.data()[19], 0x42u);
+    BOOST_REQUIRE(to_chunk(payload) == instance.operations()[2].data());
+}
+
+BOOST_AUTO_TEST_CASE(script__tokens__truncated_push__invalid_last_token)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_data(data_chunk{ 0xac, 0x4d, 0x01 }, false));
+    BOOST_REQUIRE_EQUAL(instance.tokens().size(), 2u);
+    BOOST_REQUIRE(instance.tokens().front().valid);
+    BOOST_REQUIRE(!instance.tokens().back().valid);
+    BOOST_REQUIRE(instance.tokens().back().code == instance.operations().back().code());
+}
+
+BOOST_AUTO_TEST_CASE(script__tokens__sized_pushes__match_operations)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_data(data_chunk{ 0x01, 0x42, 0x4c, 0x01, 0x42, 0x4d, 0x00, 0x00, 0xac }, false));
+    const auto& tokens = instance.tokens();
+    const auto& ops = instance.operations();
+    BOOST_REQUIRE_EQUAL(tokens.size(), ops.size());
+
+    for (size_t index = 0; index < ops.size(); ++index)
+    {
+        BOOST_REQUIRE(tokens[index].code == ops[index].code());
+        BOOST_REQUIRE(to_chunk(instance.payload(tokens[index])) == ops[index].data());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(script__is_unspendable__return_prefix__true)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_data(data_chunk{ 0x6a, 0x4d }, false));
+    BOOST_REQUIRE(instance.is_unspendable());
+    BOOST_REQUIRE(instance.from_data(data_chunk{ 0xac, 0x6a }, false));
+    BOOST_REQUIRE(!instance.is_unspendable());
+}
+
+BOOST_AUTO_TEST_CASE(script__sigops__2_of_3_multisig__legacy_and_accurate)
+{
+    script instance;
+    instance.from_string(SCRIPT_2_OF_3_MULTISIG);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.sigops(false), multisig_default_sigops);
+    BOOST_REQUIRE_EQUAL(instance.sigops(true), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(script__sigops__copy__preserves_counts)
+{
+    script instance;
+    instance.from_string("dup checksig checksigverify");
+    BOOST_REQUIRE_EQUAL(instance.sigops(false), 2u);
+    const script copy(instance);
+    BOOST_REQUIRE_EQUAL(copy.sigops(false), 2u);
+    BOOST_REQUIRE_EQUAL(copy.sigops(true), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(script__sigops__find_and_delete__recounts)
+{
+    const data_chunk endorsement{ 0x42 };
+    script instance;
+    instance.from_string("[42] checksig");
+    BOOST_REQUIRE_EQUAL(instance.sigops(false), 1u);
+    instance.find_and_delete({ endorsement });
+    BOOST_REQUIRE_EQUAL(instance.sigops(false), 1u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(script__find_and_delete__multiple_endorsements__all_deleted)
+{
+    script instance;
+    instance.from_string("[42] [4243] checksig [42] [4243] [42] [44]");
+    instance.find_and_delete({ { 0x42 }, { 0x42, 0x43 }, {} });
+    BOOST_REQUIRE(instance.to_data(false) == (data_chunk{ 0xac, 0x01, 0x44 }));
+}
+
+BOOST_AUTO_TEST_CASE(script__find_and_delete__non_minimal_push__not_deleted)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_data({ 0x4c, 0x01, 0x42, 0x01, 0x42, 0xac },
+        false));
+    instance.find_and_delete({ { 0x42 } });
+    BOOST_REQUIRE(instance.to_data(false) == (data_chunk{ 0x4c, 0x01, 0x42, 0xac }));
+}
+
+BOOST_AUTO_TEST_CASE(script__find_and_delete__trailing_invalid_push__retained)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_data({ 0x01, 0x42, 0x02, 0x42 }, false));
+    instance.find_and_delete({ { 0x42 } });
+    BOOST_REQUIRE(instance.to_data(false) == (data_chunk{ 0x02, 0x42 }));
+}
+
+BOOST_AUTO_TEST_CASE(script__find_and_delete__no_match__unchanged)
+{
+    script instance;
+    instance.from_string("[42] checksig");
+    instance.find_and_delete({ { 0x43 } });
+    BOOST_REQUIRE(instance.to_data(false) == (data_chunk{ 0x01, 0x42, 0xac }));
+    BOOST_REQUIRE_EQUAL(instance.sigops(false), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(script__sigops__from_data_after_parse__recounts)
+{
+    script instance;
+    instance.from_string("checksig checksig");
+    BOOST_REQUIRE_EQUAL(instance.sigops(false), 2u);
+    BOOST_REQUIRE(instance.from_data(data_chunk{ 0xac }, false));
+    BOOST_REQUIRE_EQUAL(instance.sigops(false), 1u);
+}
+
 // Data-driven tests.
 //------------------------------------------------------------------------------
 
@@ -1080,4 +1409,295 @@ BOOST_AUTO_TEST_CASE(script__native__bip143_no_find_and_delete_tx__valid)
     BOOST_REQUIRE_EQUAL(result0.value(), error::incorrect_signature);
 }
 
+// Branch skipping and jump register tests.
+//------------------------------------------------------------------------------
+
+code evaluate(const std::string& text, program::op_iterator* jump=nullptr)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_string(text));
+    program evaluated(instance);
+    const auto ec = evaluated.evaluate();
+
+    if (jump != nullptr)
+        *jump = evaluated.jump();
+
+    return ec;
+}
+
+BOOST_AUTO_TEST_CASE(script__branches__matched__expected_targets_and_counts)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_string("0 if nop else nop nop endif"));
+    const auto& branches = instance.branches();
+    BOOST_REQUIRE_EQUAL(branches.size(), 2u);
+    BOOST_REQUIRE_EQUAL(branches[0].from, 1u);
+    BOOST_REQUIRE_EQUAL(branches[0].to, 3u);
+    BOOST_REQUIRE_EQUAL(branches[0].counted, 1u);
+    BOOST_REQUIRE(branches[0].skippable);
+    BOOST_REQUIRE_EQUAL(branches[1].from, 3u);
+    BOOST_REQUIRE_EQUAL(branches[1].to, 6u);
+    BOOST_REQUIRE_EQUAL(branches[1].counted, 2u);
+    BOOST_REQUIRE(branches[1].skippable);
+
+    // The table is cached with the script.
+    BOOST_REQUIRE(&instance.branches() == &branches);
+}
+
+BOOST_AUTO_TEST_CASE(script__branches__disabled_or_unmatched__not_skippable)
+{
+    script instance;
+    BOOST_REQUIRE(instance.from_string("if cat endif notif"));
+    const auto& branches = instance.branches();
+    BOOST_REQUIRE_EQUAL(branches.size(), 2u);
+    BOOST_REQUIRE_EQUAL(branches[0].to, 2u);
+    BOOST_REQUIRE(!branches[0].skippable);
+    BOOST_REQUIRE_EQUAL(branches[1].from, 3u);
+    BOOST_REQUIRE(!branches[1].skippable);
+}
+
+BOOST_AUTO_TEST_CASE(script__evaluate__unexecuted_nested_branches__skipped)
+{
+    BOOST_REQUIRE_EQUAL(evaluate("0 if 0 if return endif return else 1 endif").value(), error::success);
+    BOOST_REQUIRE_EQUAL(evaluate("0 if return else 1 else return endif").value(), error::success);
+    BOOST_REQUIRE_EQUAL(evaluate("0 notif 1 else return endif").value(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(script__evaluate__unexecuted_disabled_op__op_disabled)
+{
+    BOOST_REQUIRE_EQUAL(evaluate("0 if cat endif 1").value(), error::op_disabled);
+    BOOST_REQUIRE_EQUAL(evaluate("1 if 1 else 0 if cat endif endif").value(), error::op_disabled);
+}
+
+BOOST_AUTO_TEST_CASE(script__evaluate__unexecuted_counted_ops__counted)
+{
+    std::string nops;
+    for (size_t index = 0; index < max_counted_ops - 2; ++index)
+        nops += " nop";
+
+    // The if and endif are also counted, so one more op overflows.
+    BOOST_REQUIRE_EQUAL(evaluate("0 if" + nops + " endif 1").value(), error::success);
+    BOOST_REQUIRE_EQUAL(evaluate("0 if" + nops + " nop endif 1").value(), error::invalid_operation_count);
+}
+
+BOOST_AUTO_TEST_CASE(script__evaluate__unbalanced_branch__invalid_stack_scope)
+{
+    BOOST_REQUIRE_EQUAL(evaluate("0 if 1").value(), error::invalid_stack_scope);
+}
+
+BOOST_AUTO_TEST_CASE(script__evaluate__codeseparator__jump_follows_last_executed)
+{
+    program::op_iterator jump;
+    BOOST_REQUIRE_EQUAL(evaluate("1 codeseparator 1 codeseparator 1", &jump).value(), error::success);
+    BOOST_REQUIRE(jump->code() == opcode::push_positive_1);
+
+    // An unexecuted codeseparator does not set the jump register.
+    BOOST_REQUIRE_EQUAL(evaluate("1 codeseparator 0 if codeseparator endif 1", &jump).value(), error::success);
+    BOOST_REQUIRE(jump->code() == opcode::push_size_0);
+}
+
+// Standard template differential tests.
+//------------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(script__verify_standard__pay_key_hash__matches_evaluation)
+{
+    const auto public_key = to_public_key(standard_secret1);
+    const script prevout(script::to_pay_key_hash_pattern(
+        bitcoin_short_hash(public_key)));
+    const auto endorsement = new_endorsement(standard_secret1, prevout,
+        script_version::unversioned);
+
+    const auto tx = new_spend(prevout, script(
+        operation::list{ { endorsement }, { public_key } }), {});
+    BOOST_REQUIRE(script::verify_standard(tx, 0, standard_forks,
+        prevout, standard_value));
+    require_differential(tx, standard_forks);
+    require_differential(tx, rule_fork::no_rules);
+
+    // Corrupt signature.
+    auto corrupt = endorsement;
+    corrupt[10] ^= 0x01;
+    const auto tx_corrupt = new_spend(prevout, script(
+        operation::list{ { corrupt }, { public_key } }), {});
+    BOOST_REQUIRE(!script::verify_standard(tx_corrupt, 0, standard_forks,
+        prevout, standard_value));
+    require_differential(tx_corrupt, standard_forks);
+
+    // Wrong public key.
+    const auto other_key = to_public_key(standard_secret2);
+    require_differential(new_spend(prevout, script(
+        operation::list{ { endorsement }, { other_key } }), {}),
+            standard_forks);
+
+    // Unexpected witness.
+    require_differential(new_spend(prevout, script(
+        operation::list{ { endorsement }, { public_key } }),
+            { public_key }), standard_forks);
+
+    // Wrong sighash type.
+    auto retyped = endorsement;
+    retyped.back() = sighash_algorithm::single;
+    require_differential(new_spend(prevout, script(
+        operation::list{ { retyped }, { public_key } }), {}),
+            standard_forks);
+}
+
+BOOST_AUTO_TEST_CASE(script__verify_standard__witness_key_hash__matches_evaluation)
+{
+    const auto public_key = to_public_key(standard_secret1);
+    const auto hash = bitcoin_short_hash(public_key);
+    const script prevout(operation::list{ { opcode::push_size_0 },
+        { to_chunk(hash) } });
+    const script script_code(script::to_pay_key_hash_pattern(hash));
+    const auto endorsement = new_endorsement(standard_secret1, script_code,
+        script_version::zero);
+
+    const auto tx = new_spend(prevout, {}, { endorsement, public_key });
+    BOOST_REQUIRE(script::verify_standard(tx, 0, standard_forks, prevout,
+        standard_value));
+    require_differential(tx, standard_forks);
+
+    // Witness forks inactive (not standard).
+    BOOST_REQUIRE(!script::verify_standard(tx, 0, rule_fork::bip141_rule,
+        prevout, standard_value));
+    require_differential(tx, rule_fork::bip141_rule);
+    require_differential(tx, rule_fork::bip143_rule);
+
+    // Unversioned signature hash.
+    const auto legacy = new_endorsement(standard_secret1, script_code,
+        script_version::unversioned);
+    require_differential(new_spend(prevout, {}, { legacy, public_key }),
+        standard_forks);
+
+    // Dirty input script.
+    require_differential(new_spend(prevout, script(
+        operation::list{ { opcode::push_positive_1 } }),
+            { endorsement, public_key }), standard_forks);
+
+    // Missing and extra witness elements.
+    require_differential(new_spend(prevout, {}, { public_key }),
+        standard_forks);
+    require_differential(new_spend(prevout, {},
+        { endorsement, public_key, public_key }), standard_forks);
+    require_differential(new_spend(prevout, {}, {}), standard_forks);
+}
+
+BOOST_AUTO_TEST_CASE(script__verify_standard__script_hash_witness_key_hash__matches_evaluation)
+{
+    const auto public_key = to_public_key(standard_secret2);
+    const auto hash = bitcoin_short_hash(public_key);
+    const script embedded(operation::list{ { opcode::push_size_0 },
+        { to_chunk(hash) } });
+    const auto redeem = embedded.to_data(false);
+    const script prevout(script::to_pay_script_hash_pattern(
+        bitcoin_short_hash(redeem)));
+    const script script_code(script::to_pay_key_hash_pattern(hash));
+    const auto endorsement = new_endorsement(standard_secret2, script_code,
+        script_version::zero);
+
+    const script input_script(operation::list{ { redeem } });
+    const auto tx = new_spend(prevout, input_script,
+        { endorsement, public_key });
+    BOOST_REQUIRE(script::verify_standard(tx, 0, standard_forks, prevout,
+        standard_value));
+    require_differential(tx, standard_forks);
+
+    // Missing bip16 (witness not consumed).
+    require_differential(tx, rule_fork::bip141_rule | rule_fork::bip143_rule);
+
+    // Extra input script push.
+    require_differential(new_spend(prevout, script(
+        operation::list{ { public_key }, { redeem } }),
+            { endorsement, public_key }), standard_forks);
+
+    // Wrong key.
+    require_differential(new_spend(prevout, input_script,
+        { endorsement, to_public_key(standard_secret1) }), standard_forks);
+}
+
+BOOST_AUTO_TEST_CASE(script__verify_standard__witness_multisig__matches_evaluation)
+{
+    const auto key1 = to_public_key(standard_secret1);
+    const auto key2 = to_public_key(standard_secret2);
+    const auto key3 = to_public_key(standard_secret3);
+    const script witness_script(script::to_pay_multisig_pattern(2,
+        data_stack{ key1, key2, key3 }));
+    const auto encoded = witness_script.to_data(false);
+    const script prevout(operation::list{ { opcode::push_size_0 },
+        { to_chunk(sha256_hash(encoded)) } });
+
+    const auto sig1 = new_endorsement(standard_secret1, witness_script,
+        script_version::zero);
+    const auto sig2 = new_endorsement(standard_secret2, witness_script,
+        script_version::zero);
+    const auto sig3 = new_endorsement(standard_secret3, witness_script,
+        script_version::zero);
+
+    const auto tx = new_spend(prevout, {}, { {}, sig1, sig3, encoded });
+    BOOST_REQUIRE(script::verify_standard(tx, 0, standard_forks, prevout,
+        standard_value));
+    require_differential(tx, standard_forks);
+    require_differential(new_spend(prevout, {}, { {}, sig1, sig2, encoded }),
+        standard_forks);
+    require_differential(new_spend(prevout, {}, { {}, sig2, sig3, encoded }),
+        standard_forks);
+
+    // Out of order signatures.
+    const auto reordered = new_spend(prevout, {}, { {}, sig3, sig1, encoded });
+    BOOST_REQUIRE(!script::verify_standard(reordered, 0, standard_forks,
+        prevout, standard_value));
+    require_differential(reordered, standard_forks);
+
+    // Duplicated signature.
+    require_differential(new_spend(prevout, {}, { {}, sig1, sig1, encoded }),
+        standard_forks);
+
+    // Non-empty dummy, with and without bip147.
+    const auto dummy = new_spend(prevout, {}, { { 0x01 }, sig1, sig3, encoded });
+    require_differential(dummy, standard_forks);
+    require_differential(dummy, standard_forks & ~rule_fork::bip147_rule);
+
+    // Missing and extra signatures.
+    require_differential(new_spend(prevout, {}, { {}, sig1, encoded }),
+        standard_forks);
+    require_differential(new_spend(prevout, {},
+        { {}, sig1, sig2, sig3, encoded }), standard_forks);
+
+    // Empty signature.
+    require_differential(new_spend(prevout, {}, { {}, {}, sig3, encoded }),
+        standard_forks);
+}
+
+BOOST_AUTO_TEST_CASE(script__verify__multisig_mixed_sighash_types__expected)
+{
+    const auto key1 = to_public_key(standard_secret1);
+    const auto key2 = to_public_key(standard_secret2);
+    const auto key3 = to_public_key(standard_secret3);
+    const script prevout(script::to_pay_multisig_pattern(2,
+        data_stack{ key1, key2, key3 }));
+
+    const auto sig1 = new_endorsement(standard_secret1, prevout,
+        script_version::unversioned);
+    const auto sig2 = new_endorsement(standard_secret2, prevout,
+        script_version::unversioned, sighash_algorithm::single);
+    const auto sig3 = new_endorsement(standard_secret3, prevout,
+        script_version::unversioned, sighash_algorithm::none);
+
+    const auto spend = [&](const endorsement& first, const endorsement& second)
+    {
+        return new_spend(prevout, script(operation::list{
+            { opcode::push_size_0 }, { first }, { second } }), {});
+    };
+
+    BOOST_REQUIRE_EQUAL(script::verify(spend(sig1, sig2), 0, standard_forks).value(), error::success);
+    BOOST_REQUIRE_EQUAL(script::verify(spend(sig2, sig3), 0, standard_forks).value(), error::success);
+    BOOST_REQUIRE_EQUAL(script::verify(spend(sig1, sig3), 0, standard_forks).value(), error::success);
+    BOOST_REQUIRE_EQUAL(script::verify(spend(sig2, sig1), 0, standard_forks).value(), error::stack_false);
+
+    // Sighash type of another endorsement (shared hash must not be reused).
+    auto retyped = sig2;
+    retyped.back() = sighash_algorithm::all;
+    BOOST_REQUIRE_EQUAL(script::verify(spend(sig1, retyped), 0, standard_forks).value(), error::stack_false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
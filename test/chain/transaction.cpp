@@ -508,6 +508,41 @@ BOOST_AUTO_TEST_CASE(transaction__factory_data_1__case_2__success)
     BOOST_REQUIRE(resave == raw_tx);
 }
 
+BOOST_AUTO_TEST_CASE(transaction__serialized_size__set_outputs__invalidates_cache)
+{
+    static const auto raw_tx = to_chunk(base16_literal(TX1));
+    auto tx = chain::transaction::factory(raw_tx);
+    BOOST_REQUIRE_EQUAL(tx.serialized_size(), 225u);
+    BOOST_REQUIRE_EQUAL(tx.weight(), 4u * 225u);
+
+    auto outputs = tx.outputs();
+    outputs.emplace_back(42u, chain::script{});
+    tx.set_outputs(std::move(outputs));
+    BOOST_REQUIRE_EQUAL(tx.serialized_size(), tx.to_data().size());
+    BOOST_REQUIRE_EQUAL(tx.serialized_size(), 225u + 9u);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__serialized_size__mutable_outputs__invalidates_cache)
+{
+    static const auto raw_tx = to_chunk(base16_literal(TX1));
+    auto tx = chain::transaction::factory(raw_tx);
+    BOOST_REQUIRE_EQUAL(tx.serialized_size(), 225u);
+
+    tx.outputs().emplace_back(42u, chain::script{});
+    BOOST_REQUIRE_EQUAL(tx.serialized_size(), tx.to_data().size());
+    BOOST_REQUIRE_EQUAL(tx.serialized_size(), 225u + 9u);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__serialized_size__mutable_input_script__invalidates_cache)
+{
+    static const auto raw_tx = to_chunk(base16_literal(TX1));
+    auto tx = chain::transaction::factory(raw_tx);
+    BOOST_REQUIRE_EQUAL(tx.serialized_size(), 225u);
+
+    tx.inputs().front().set_script(chain::script{});
+    BOOST_REQUIRE_EQUAL(tx.serialized_size(), tx.to_data().size());
+}
+
 BOOST_AUTO_TEST_CASE(transaction__factory_data_2__case_1__success)
 {
     static const auto tx_hash = hash_literal(TX1_HASH);
@@ -806,6 +841,76 @@ BOOST_AUTO_TEST_CASE(transaction__signature_operations_single_input_output_unini
     BOOST_REQUIRE_EQUAL(instance.signature_operations(false, false), 0u);
 }
 
+BOOST_AUTO_TEST_CASE(transaction__signature_operations__set_outputs__invalidates_cache)
+{
+    chain::transaction instance;
+    instance.inputs().emplace_back();
+    instance.outputs().emplace_back();
+    BOOST_REQUIRE_EQUAL(instance.signature_operations(false, false), 0u);
+
+    chain::output::list outputs(1);
+    outputs.back().set_script(chain::script(
+        machine::operation::list{ machine::opcode::checksig }));
+    instance.set_outputs(outputs);
+    BOOST_REQUIRE_EQUAL(instance.signature_operations(false, false), 1u);
+    BOOST_REQUIRE_EQUAL(instance.signature_operations(false, true), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__signature_operations__mutable_outputs__invalidates_cache)
+{
+    chain::transaction instance;
+    instance.inputs().emplace_back();
+    instance.outputs().emplace_back();
+    BOOST_REQUIRE_EQUAL(instance.signature_operations(false, false), 0u);
+
+    instance.outputs().back().set_script(chain::script(
+        machine::operation::list{ machine::opcode::checksig }));
+    BOOST_REQUIRE_EQUAL(instance.signature_operations(false, false), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__signature_operations__prevout_populated_later__counts_embedded)
+{
+    const chain::script embedded(
+        machine::operation::list{ machine::opcode::checksig });
+    const auto redeem = embedded.to_data(false);
+
+    chain::input::list inputs(1);
+    inputs.back().previous_output().set_hash(hash_literal(
+        "0000000000000000000000000000000000000000000000000000000000000001"));
+    inputs.back().set_script(chain::script(
+        machine::operation::list{ machine::operation(redeem) }));
+
+    chain::transaction instance;
+    instance.set_inputs(inputs);
+
+    // The embedded sigop is not counted (or cached) without the prevout.
+    BOOST_REQUIRE_EQUAL(instance.signature_operations(true, false), 0u);
+
+    const auto& input =
+        static_cast<const chain::transaction&>(instance).inputs().back();
+    auto& prevout = input.previous_output().metadata.cache;
+    prevout.set_value(0);
+    prevout.set_script(chain::script(chain::script::to_pay_script_hash_pattern(
+        bitcoin_short_hash(redeem))));
+    BOOST_REQUIRE_EQUAL(instance.signature_operations(true, false), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__check__legacy_sigops_exceed_limit__transaction_legacy_sigop_limit)
+{
+    chain::transaction instance;
+    chain::input::list inputs(1);
+    inputs.back().previous_output().set_hash(hash_literal(
+        "0000000000000000000000000000000000000000000000000000000000000001"));
+    instance.set_inputs(inputs);
+
+    chain::output::list outputs(1);
+    outputs.back().set_script(chain::script(machine::operation::list(
+        max_block_sigops + 1, machine::operation{ machine::opcode::checksig })));
+    instance.set_outputs(outputs);
+
+    BOOST_REQUIRE_EQUAL(instance.check(max_uint64), error::transaction_legacy_sigop_limit);
+}
+
 BOOST_AUTO_TEST_CASE(transaction__is_missing_previous_outputs__empty_inputs__returns_false)
 {
     chain::transaction instance;
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(chain_transaction_view_tests)
+
+#define BIP143_P2WPKH_TX "01000000000102fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f00000000494830450221008b9d1dc26ba6a9cb62127b02742fa9d754cd3bebf337f7a55d114c8e5cdd30be022040529b194ba3f9281a99f2b1c0a19c0489bc22ede944ccf4ecbab4cc618ef3ed01eeffffffef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a0100000000ffffffff02202cb206000000001976a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac9093510d000000001976a9143bde42dbee7e4dbe6a21b2d50ce2f0167faa815988ac000247304402203609e17b84f6a7d30c80bfa610b5b4542f32a8a0d5447a12fb1366d7f01cc44a0220573a954c4518331561406f90300e8f3358f51928d43c212a8caed02de67eebee0121025476c2e83188368da1ff3e292e7acafcdb3566bb0ad253f62fc70f07aeee635711000000"
+
+BOOST_AUTO_TEST_CASE(transaction_view__constructor_1__always__invalid)
+{
+    chain::transaction_view instance;
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.inputs_size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.outputs_size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__from_data__segregated__matches_transaction)
+{
+    data_chunk raw_tx;
+    BOOST_REQUIRE(decode_base16(raw_tx, BIP143_P2WPKH_TX));
+    const auto tx = chain::transaction::factory(raw_tx, true, true);
+    const chain::transaction_view instance(raw_tx);
+
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.is_segregated());
+    BOOST_REQUIRE_EQUAL(instance.version(), tx.version());
+    BOOST_REQUIRE_EQUAL(instance.locktime(), tx.locktime());
+    BOOST_REQUIRE_EQUAL(instance.inputs_size(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.outputs_size(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(true), tx.serialized_size(true, true));
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(false), tx.serialized_size(true, false));
+    BOOST_REQUIRE(instance.hash(false) == tx.hash(false));
+    BOOST_REQUIRE(instance.hash(true) == tx.hash(true));
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__input__segregated__includes_witness)
+{
+    data_chunk raw_tx;
+    BOOST_REQUIRE(decode_base16(raw_tx, BIP143_P2WPKH_TX));
+    const auto tx = chain::transaction::factory(raw_tx, true, true);
+    const chain::transaction_view instance(raw_tx);
+
+    BOOST_REQUIRE(instance.input(0) == tx.inputs()[0]);
+    BOOST_REQUIRE(instance.input(1).witness() == tx.inputs()[1].witness());
+    BOOST_REQUIRE_EQUAL(instance.input(1).witness().stack().size(), 2u);
+    BOOST_REQUIRE(instance.output(1) == tx.outputs()[1]);
+    BOOST_REQUIRE_EQUAL(instance.output_value(0), tx.outputs()[0].value());
+    BOOST_REQUIRE(instance.to_transaction() == tx);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__measure__trailing_data__transaction_size)
+{
+    data_chunk raw_tx;
+    BOOST_REQUIRE(decode_base16(raw_tx, BIP143_P2WPKH_TX));
+    const auto size = raw_tx.size();
+    raw_tx.push_back(0x42);
+    BOOST_REQUIRE_EQUAL(chain::transaction_view::measure(raw_tx), size);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__measure__truncated__zero)
+{
+    data_chunk raw_tx;
+    BOOST_REQUIRE(decode_base16(raw_tx, BIP143_P2WPKH_TX));
+    raw_tx.pop_back();
+    BOOST_REQUIRE_EQUAL(chain::transaction_view::measure(raw_tx), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
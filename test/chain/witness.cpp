@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+
+static const data_stack witness_stack{ { 0x42 }, {}, { 0x01, 0x02, 0x03 } };
+static const data_chunk witness_encoded{ 0x03, 0x01, 0x42, 0x00, 0x03, 0x01, 0x02, 0x03 };
+
+BOOST_AUTO_TEST_SUITE(witness_tests)
+
+BOOST_AUTO_TEST_CASE(witness__constructor__default__invalid_empty)
+{
+    const witness instance;
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE(instance.begin() == instance.end());
+}
+
+BOOST_AUTO_TEST_CASE(witness__constructor__stack__expected_elements)
+{
+    const witness instance(witness_stack);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.size(), 3u);
+    BOOST_REQUIRE(to_chunk(instance.front()) == witness_stack[0]);
+    BOOST_REQUIRE(instance[1].empty());
+    BOOST_REQUIRE(to_chunk(instance.back()) == witness_stack[2]);
+    BOOST_REQUIRE(instance.stack() == witness_stack);
+}
+
+BOOST_AUTO_TEST_CASE(witness__from_data__prefixed__round_trips)
+{
+    witness instance;
+    BOOST_REQUIRE(instance.from_data(witness_encoded, true));
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance == witness(witness_stack));
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(true), witness_encoded.size());
+    BOOST_REQUIRE(instance.to_data(true) == witness_encoded);
+}
+
+BOOST_AUTO_TEST_CASE(witness__from_data__unprefixed__round_trips)
+{
+    const data_chunk encoded(witness_encoded.begin() + 1, witness_encoded.end());
+    witness instance;
+    BOOST_REQUIRE(instance.from_data(encoded, false));
+    BOOST_REQUIRE(instance.stack() == witness_stack);
+    BOOST_REQUIRE(instance.to_data(false) == encoded);
+}
+
+BOOST_AUTO_TEST_CASE(witness__from_data__truncated_element__invalid)
+{
+    const data_chunk truncated(witness_encoded.begin(), witness_encoded.end() - 1);
+    witness instance;
+    BOOST_REQUIRE(!instance.from_data(truncated, true));
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE(instance.empty());
+}
+
+BOOST_AUTO_TEST_CASE(witness__from_data__oversized_count_truncated__invalid)
+{
+    // Claims 0x00ffffff elements but provides only one.
+    const data_chunk encoded{ 0xfe, 0xff, 0xff, 0xff, 0x00, 0x01, 0x42 };
+    witness instance;
+    BOOST_REQUIRE(!instance.from_data(encoded, true));
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE(instance.empty());
+}
+
+BOOST_AUTO_TEST_CASE(witness__iteration__expected_elements)
+{
+    const witness instance(witness_stack);
+    data_stack elements;
+
+    for (const auto element: instance)
+        elements.push_back(to_chunk(element));
+
+    BOOST_REQUIRE(elements == witness_stack);
+}
+
+BOOST_AUTO_TEST_CASE(witness__operator_equals__different_boundaries__false)
+{
+    const witness instance1(data_stack{ { 0x01 }, { 0x02, 0x03 } });
+    const witness instance2(data_stack{ { 0x01, 0x02 }, { 0x03 } });
+    BOOST_REQUIRE(instance1 != instance2);
+}
+
+BOOST_AUTO_TEST_CASE(witness__is_push_size__oversized_element__false)
+{
+    const witness instance(data_stack{ { 0x01 },
+        data_chunk(max_push_data_size + 1, 0x00) });
+    BOOST_REQUIRE(instance.is_push_size(1));
+    BOOST_REQUIRE(!instance.is_push_size(2));
+}
+
+BOOST_AUTO_TEST_CASE(witness__is_reserved_pattern__single_hash__true)
+{
+    BOOST_REQUIRE(witness(data_stack{ to_chunk(null_hash) }).is_reserved_pattern());
+    BOOST_REQUIRE(!witness(data_stack{ to_chunk(null_hash), {} }).is_reserved_pattern());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
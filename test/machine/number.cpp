@@ -18,6 +18,7 @@
  */
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <limits>
@@ -445,4 +446,26 @@ BOOST_AUTO_TEST_CASE(make_operator_expectations)
 }
 #endif
 
+BOOST_AUTO_TEST_CASE(number__data__encoding__matches_chunk)
+{
+    static const int64_t values[] =
+    {
+        0, 1, -1, 127, -127, 128, -128, 255, -255, 256, -256, 32767, -32768,
+        8388607, -8388608, 2147483647, -2147483647,
+        std::numeric_limits<int64_t>::max(),
+        std::numeric_limits<int64_t>::min() + 1
+    };
+
+    for (const auto value: values)
+    {
+        const number script_number(value);
+        number::encoding encoded;
+        const auto size = script_number.data(encoded);
+        const auto expected = script_number.data();
+        BOOST_REQUIRE_EQUAL(size, expected.size());
+        BOOST_REQUIRE(std::equal(expected.begin(), expected.end(),
+            encoded.begin()));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
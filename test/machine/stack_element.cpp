@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::machine;
+
+BOOST_AUTO_TEST_SUITE(stack_element_tests)
+
+BOOST_AUTO_TEST_CASE(stack_element__constructor_1__always__empty)
+{
+    stack_element instance;
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE(instance.begin() == instance.end());
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__constructor__inline_chunk__expected)
+{
+    const data_chunk value(stack_element::capacity, 0x42);
+    stack_element instance(value);
+    BOOST_REQUIRE_EQUAL(instance.size(), value.size());
+    BOOST_REQUIRE(instance.to_chunk() == value);
+    BOOST_REQUIRE(instance.data() != value.data());
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__constructor__moved_heap_chunk__adopts_buffer)
+{
+    data_chunk value(stack_element::capacity + 1, 0x42);
+    const auto expected = value;
+    const auto buffer = value.data();
+    stack_element instance(std::move(value));
+    BOOST_REQUIRE_EQUAL(instance.size(), expected.size());
+    BOOST_REQUIRE(instance.data() == buffer);
+    BOOST_REQUIRE(instance.to_chunk() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__constructor__byte_array__expected)
+{
+    const auto hash = bitcoin_short_hash(to_chunk(base16_literal("0102")));
+    stack_element instance(hash);
+    BOOST_REQUIRE_EQUAL(instance.size(), short_hash_size);
+    BOOST_REQUIRE(instance.to_chunk() == to_chunk(hash));
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__constructor__byte__expected)
+{
+    stack_element instance(uint8_t{ 0x81 });
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.front(), 0x81);
+    BOOST_REQUIRE_EQUAL(instance.back(), 0x81);
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__move_assign__inline__source_empty)
+{
+    stack_element source(data_chunk{ 1, 2, 3 });
+    stack_element instance;
+    instance = std::move(source);
+    BOOST_REQUIRE(source.empty());
+    BOOST_REQUIRE(instance.to_chunk() == (data_chunk{ 1, 2, 3 }));
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__copy_assign__heap_to_inline__expected)
+{
+    const stack_element large(data_chunk(stack_element::capacity + 10, 0x01));
+    const stack_element small(data_chunk{ 0x02 });
+    stack_element instance(large);
+    BOOST_REQUIRE_EQUAL(instance.size(), large.size());
+    instance = small;
+    BOOST_REQUIRE(instance == small);
+    BOOST_REQUIRE(instance != large);
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__equality__same_bytes__true)
+{
+    const stack_element left(data_chunk{ 0xab, 0xcd });
+    const stack_element right(data_chunk{ 0xab, 0xcd });
+    BOOST_REQUIRE(left == right);
+    BOOST_REQUIRE(left != stack_element(data_chunk{ 0xab }));
+}
+
+BOOST_AUTO_TEST_CASE(stack_element__data_slice__conversion__expected)
+{
+    const stack_element instance(data_chunk{ 0x01, 0x02, 0x03 });
+    const data_slice slice(instance);
+    BOOST_REQUIRE_EQUAL(slice.size(), 3u);
+    BOOST_REQUIRE(slice.data() == instance.data());
+    BOOST_REQUIRE_EQUAL(encode_base16(instance), "010203");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(golomb_coding_tests)
+
+static const siphash_key key = to_siphash_key(base16_literal("000102030405060708090a0b0c0d0e0f"));
+static const uint8_t bits = 19;
+static const uint64_t rate = 784931;
+
+static const data_chunk item1 = to_chunk(base16_literal("00"));
+static const data_chunk item2 = to_chunk(base16_literal("0102"));
+static const data_chunk item3 = to_chunk(base16_literal("030405"));
+static const data_chunk item4 = to_chunk(base16_literal("06070809"));
+static const data_chunk absent = to_chunk(base16_literal("ff"));
+
+static const std::vector<data_slice> items{ item1, item2, item3, item4 };
+
+BOOST_AUTO_TEST_CASE(golomb_coding__golomb_construct__empty__empty)
+{
+    BOOST_REQUIRE(golomb_construct({}, bits, key, rate).empty());
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coding__golomb_match__empty_set__false)
+{
+    BOOST_REQUIRE(!golomb_match(item1, data_chunk{}, 0, bits, key, rate));
+    BOOST_REQUIRE(!golomb_match(items, data_chunk{}, 0, bits, key, rate));
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coding__golomb_match__each_item__true)
+{
+    const auto set = golomb_construct(items, bits, key, rate);
+
+    for (const auto& item: items)
+        BOOST_REQUIRE(golomb_match(item, set, items.size(), bits, key, rate));
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coding__golomb_match__absent_item__false)
+{
+    const auto set = golomb_construct(items, bits, key, rate);
+    BOOST_REQUIRE(!golomb_match(absent, set, items.size(), bits, key, rate));
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coding__golomb_match__targets_including_item__true)
+{
+    const auto set = golomb_construct(items, bits, key, rate);
+    const std::vector<data_slice> targets{ absent, item3 };
+    BOOST_REQUIRE(golomb_match(targets, set, items.size(), bits, key, rate));
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coding__golomb_match__absent_targets__false)
+{
+    const auto set = golomb_construct(items, bits, key, rate);
+    const std::vector<data_slice> targets{ absent };
+    BOOST_REQUIRE(!golomb_match(targets, set, items.size(), bits, key, rate));
+    BOOST_REQUIRE(!golomb_match({}, set, items.size(), bits, key, rate));
+}
+
+BOOST_AUTO_TEST_CASE(golomb_coding__golomb_match__truncated_set__false)
+{
+    auto set = golomb_construct(items, bits, key, rate);
+    set.resize(1);
+
+    for (const auto& item: items)
+        BOOST_REQUIRE(!golomb_match(item, set, items.size(), bits, key, rate));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
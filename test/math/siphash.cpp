@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(siphash_tests)
+
+// Test vectors from the siphash reference implementation (key 00..0f).
+
+static const half_hash key = base16_literal("000102030405060708090a0b0c0d0e0f");
+
+static data_chunk counting(size_t size)
+{
+    data_chunk data(size);
+    for (size_t index = 0; index < size; ++index)
+        data[index] = static_cast<uint8_t>(index);
+
+    return data;
+}
+
+BOOST_AUTO_TEST_CASE(siphash__to_siphash_key__halves__little_endian)
+{
+    const auto result = to_siphash_key(key);
+    BOOST_REQUIRE_EQUAL(std::get<0>(result), 0x0706050403020100u);
+    BOOST_REQUIRE_EQUAL(std::get<1>(result), 0x0f0e0d0c0b0a0908u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__empty__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(key, data_chunk{}), 0x726fdb47dd0e0e31u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__one_byte__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(key, counting(1)), 0x74f839c593dc67fdu);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__partial_block__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(key, counting(7)), 0xab0200f58b01d137u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__one_block__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(key, counting(8)), 0x93f5f5799a932462u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__block_and_partial_block__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(key, counting(15)), 0xa129ca6149be45e5u);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__two_blocks__expected)
+{
+    BOOST_REQUIRE_EQUAL(siphash(key, counting(16)), 0x3f2acc7f57c29bdbu);
+}
+
+BOOST_AUTO_TEST_CASE(siphash__siphash__key_overload__same)
+{
+    const auto data = counting(15);
+    BOOST_REQUIRE_EQUAL(siphash(to_siphash_key(key), data), siphash(key, data));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -466,4 +466,86 @@ BOOST_AUTO_TEST_CASE(block__operator_boolean_not_equals_2__differs__returns_true
     BOOST_REQUIRE(instance != expected);
 }
 
+BOOST_AUTO_TEST_CASE(block__to_wire__same_key__shared_and_equals_serialize)
+{
+    block instance(
+        chain::header(10u, null_hash, null_hash, 531234u, 6523454u, 68644u),
+        { chain::transaction(1, 48, {}, {}), chain::transaction(2, 32, {}, {}) });
+
+    const auto first = instance.to_wire(version::level::minimum, 0x0709110b);
+    const auto second = instance.to_wire(version::level::minimum, 0x0709110b);
+    BOOST_REQUIRE(first);
+    BOOST_REQUIRE(first == second);
+    BOOST_REQUIRE(*first == serialize(version::level::minimum, instance, 0x0709110b));
+}
+
+BOOST_AUTO_TEST_CASE(block__to_wire__different_magic__reserialized)
+{
+    block instance(
+        chain::header(10u, null_hash, null_hash, 531234u, 6523454u, 68644u),
+        { chain::transaction(1, 48, {}, {}), chain::transaction(2, 32, {}, {}) });
+
+    const auto first = instance.to_wire(version::level::minimum, 0x0709110b);
+    const auto second = instance.to_wire(version::level::minimum, 0xd9b4bef9);
+    BOOST_REQUIRE(first != second);
+    BOOST_REQUIRE(*second == serialize(version::level::minimum, instance, 0xd9b4bef9));
+}
+
+BOOST_AUTO_TEST_CASE(block__to_wire__different_witness__reserialized)
+{
+    block instance(
+        chain::header(10u, null_hash, null_hash, 531234u, 6523454u, 68644u),
+        { chain::transaction(1, 48, {}, {}), chain::transaction(2, 32, {}, {}) });
+
+    const auto first = instance.to_wire(version::level::minimum, 0x0709110b);
+    const auto second = instance.to_wire(version::level::minimum, 0x0709110b, false);
+    BOOST_REQUIRE(first != second);
+    BOOST_REQUIRE(*second == serialize(version::level::minimum, instance, 0x0709110b));
+}
+
+BOOST_AUTO_TEST_CASE(block__to_wire__set_transactions__reserialized)
+{
+    block instance(
+        chain::header(10u, null_hash, null_hash, 531234u, 6523454u, 68644u),
+        { chain::transaction(1, 48, {}, {}), chain::transaction(2, 32, {}, {}) });
+
+    const auto first = instance.to_wire(version::level::minimum, 0x0709110b);
+    instance.set_transactions({ chain::transaction(4, 16, {}, {}) });
+    const auto second = instance.to_wire(version::level::minimum, 0x0709110b);
+    BOOST_REQUIRE(first != second);
+    BOOST_REQUIRE(*second == serialize(version::level::minimum, instance, 0x0709110b));
+}
+
+BOOST_AUTO_TEST_CASE(block__to_wire__mutable_transactions__reserialized)
+{
+    block instance(
+        chain::header(10u, null_hash, null_hash, 531234u, 6523454u, 68644u),
+        { chain::transaction(1, 48, {}, {}), chain::transaction(2, 32, {}, {}) });
+
+    const auto first = instance.to_wire(version::level::minimum, 0x0709110b);
+    instance.transactions().front().set_locktime(16);
+    const auto second = instance.to_wire(version::level::minimum, 0x0709110b);
+    BOOST_REQUIRE(first != second);
+    BOOST_REQUIRE(*second == serialize(version::level::minimum, instance, 0x0709110b));
+}
+
+BOOST_AUTO_TEST_CASE(block__to_wire__chain_header_setter__reserialized)
+{
+    block instance(
+        chain::header(10u, null_hash, null_hash, 531234u, 6523454u, 68644u),
+        { chain::transaction(1, 48, {}, {}), chain::transaction(2, 32, {}, {}) });
+
+    const auto first = instance.to_wire(version::level::minimum, 0x0709110b);
+    static_cast<chain::block&>(instance).set_header(
+        chain::header(11u, null_hash, null_hash, 531234u, 6523454u, 68644u));
+    const auto second = instance.to_wire(version::level::minimum, 0x0709110b);
+    BOOST_REQUIRE(first != second);
+    BOOST_REQUIRE(*second == serialize(version::level::minimum, instance, 0x0709110b));
+}
+
+BOOST_AUTO_TEST_CASE(block__chain_base__not_polymorphic)
+{
+    BOOST_REQUIRE(!std::is_polymorphic<chain::block>::value);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
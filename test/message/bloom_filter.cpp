@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+
+BOOST_AUTO_TEST_SUITE(bloom_filter_tests)
+
+// Vectors from the bitcoin core bloom filter tests (3 bytes, 5 functions).
+static const data_chunk element1 = to_chunk(base16_literal("99108ad8ed9bb6274d3980bab5a85c048f0950c8"));
+static const data_chunk element2 = to_chunk(base16_literal("b5a2c786d9ef4658287ced5914b37a1b4aa32eee"));
+static const data_chunk element3 = to_chunk(base16_literal("b9300670b4c5366e95b2699e8b18bc75e5f729c5"));
+static const data_chunk other = to_chunk(base16_literal("19108ad8ed9bb6274d3980bab5a85c048f0950c8"));
+
+static const short_hash key_hash = base16_literal("0102030405060708090a0b0c0d0e0f1011121314");
+
+static transaction make_payment(const machine::operation::list& ops)
+{
+    return transaction(1, 0, { input(output_point(null_hash, 0), script{}, 0) },
+        { output(42, script(ops)) });
+}
+
+static transaction make_spend(const hash_digest& hash, uint32_t index)
+{
+    return transaction(1, 0, { input(output_point(hash, index), script{}, 0) },
+        {});
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__constructor_1__always__contains_nothing)
+{
+    message::bloom_filter instance;
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(!instance.contains(element1));
+    instance.insert(element1);
+    BOOST_REQUIRE(!instance.contains(element1));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__constructor_2__filter_load__expected)
+{
+    const message::filter_load load(to_chunk(base16_literal("614e9b")), 5, 0, message::bloom_filter::update_all);
+    const message::bloom_filter instance(load);
+    BOOST_REQUIRE(instance.filter() == load.filter());
+    BOOST_REQUIRE_EQUAL(instance.hash_functions(), 5u);
+    BOOST_REQUIRE_EQUAL(instance.tweak(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.flags(), message::bloom_filter::update_all);
+    BOOST_REQUIRE(instance.contains(element1));
+    BOOST_REQUIRE(instance.contains(element2));
+    BOOST_REQUIRE(instance.contains(element3));
+    BOOST_REQUIRE(!instance.contains(other));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__insert__cleared_filter__expected_bits)
+{
+    message::bloom_filter instance(data_chunk(3, 0x00), 5, 0, message::bloom_filter::update_none);
+    BOOST_REQUIRE(!instance.contains(element1));
+    instance.insert(element1);
+    instance.insert(element2);
+    instance.insert(element3);
+    BOOST_REQUIRE(instance.filter() == to_chunk(base16_literal("614e9b")));
+    BOOST_REQUIRE(instance.contains(element1));
+    BOOST_REQUIRE(!instance.contains(other));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__is_valid__oversized__false)
+{
+    const message::bloom_filter instance(data_chunk(max_filter_load + 1, 0x00), 5, 0, 0);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__is_valid__excess_hash_functions__false)
+{
+    const message::bloom_filter instance(data_chunk(3, 0x00), max_filter_functions + 1, 0, 0);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__matches__full_filter__true)
+{
+    message::bloom_filter instance(data_chunk(3, 0xff), 5, 0, message::bloom_filter::update_none);
+    BOOST_REQUIRE(instance.matches(make_spend(null_hash, 0)));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__matches__cleared_filter__false)
+{
+    message::bloom_filter instance(data_chunk(3, 0x00), 5, 0, message::bloom_filter::update_all);
+    BOOST_REQUIRE(!instance.matches(make_payment(script::to_pay_key_hash_pattern(key_hash))));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__matches__txid__true)
+{
+    const auto tx = make_spend(null_hash, 0);
+    message::bloom_filter instance(data_chunk(64, 0x00), 10, 42, message::bloom_filter::update_none);
+    instance.insert(tx.hash());
+    BOOST_REQUIRE(instance.matches(tx));
+    BOOST_REQUIRE(!instance.matches(make_spend(null_hash, 1)));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__matches__output_push_update_all__outpoint_added)
+{
+    const auto payment = make_payment(script::to_pay_key_hash_pattern(key_hash));
+    message::bloom_filter instance(data_chunk(64, 0x00), 10, 42, message::bloom_filter::update_all);
+    instance.insert(key_hash);
+    BOOST_REQUIRE(instance.matches(payment));
+    BOOST_REQUIRE(instance.matches(make_spend(payment.hash(), 0)));
+    BOOST_REQUIRE(!instance.matches(make_spend(payment.hash(), 1)));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__matches__output_push_update_none__outpoint_not_added)
+{
+    const auto payment = make_payment(script::to_pay_key_hash_pattern(key_hash));
+    message::bloom_filter instance(data_chunk(64, 0x00), 10, 42, message::bloom_filter::update_none);
+    instance.insert(key_hash);
+    BOOST_REQUIRE(instance.matches(payment));
+    BOOST_REQUIRE(!instance.matches(make_spend(payment.hash(), 0)));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__matches__key_hash_update_p2pubkey_only__outpoint_not_added)
+{
+    const auto payment = make_payment(script::to_pay_key_hash_pattern(key_hash));
+    message::bloom_filter instance(data_chunk(64, 0x00), 10, 42, message::bloom_filter::update_p2pubkey_only);
+    instance.insert(key_hash);
+    BOOST_REQUIRE(instance.matches(payment));
+    BOOST_REQUIRE(!instance.matches(make_spend(payment.hash(), 0)));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__matches__public_key_update_p2pubkey_only__outpoint_added)
+{
+    const auto point = to_chunk(base16_literal("0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"));
+    const auto payment = make_payment(script::to_pay_public_key_pattern(point));
+    message::bloom_filter instance(data_chunk(64, 0x00), 10, 42, message::bloom_filter::update_p2pubkey_only);
+    instance.insert(point);
+    BOOST_REQUIRE(instance.matches(payment));
+    BOOST_REQUIRE(instance.matches(make_spend(payment.hash(), 0)));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter__matches__input_push__true)
+{
+    const auto tx = transaction(1, 0,
+        { input(output_point(null_hash, 0), script({ machine::operation(element1) }), 0) }, {});
+    message::bloom_filter instance(data_chunk(64, 0x00), 10, 42, message::bloom_filter::update_none);
+    instance.insert(element1);
+    BOOST_REQUIRE(instance.matches(tx));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,22 @@
 
 using namespace bc;
 
+static chain::block make_block()
+{
+    chain::transaction::list transactions
+    {
+        chain::transaction(1, 0, {}, {}),
+        chain::transaction(1, 1, {}, {}),
+        chain::transaction(1, 2, {}, {}),
+        chain::transaction(1, 3, {}, {})
+    };
+
+    chain::block block(chain::header(10u, null_hash, null_hash, 531234u,
+        6523454u, 68644u), transactions);
+    block.header().set_merkle(block.generate_merkle_root());
+    return block;
+}
+
 BOOST_AUTO_TEST_SUITE(compact_block_tests)
 
 BOOST_AUTO_TEST_CASE(compact_block__constructor_1__always__invalid)
@@ -709,5 +725,122 @@ BOOST_AUTO_TEST_CASE(compact_block__operator_boolean_not_equals__differs__return
     BOOST_REQUIRE(instance != expected);
 }
 
+BOOST_AUTO_TEST_CASE(compact_block__factory_4__block__coinbase_prefilled_others_short_ids)
+{
+    auto block = make_block();
+    const auto instance = message::compact_block::factory(block, 42u);
+    const auto key = instance.short_id_key();
+    BOOST_REQUIRE(instance.header() == block.header());
+    BOOST_REQUIRE_EQUAL(instance.nonce(), 42u);
+    BOOST_REQUIRE_EQUAL(instance.transactions().size(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.transactions()[0].index(), 0u);
+    BOOST_REQUIRE(instance.transactions()[0].transaction() == block.transactions()[0]);
+    BOOST_REQUIRE_EQUAL(instance.short_ids().size(), 3u);
+
+    for (size_t index = 1; index < 4; ++index)
+    {
+        const auto hash = block.transactions()[index].hash();
+        BOOST_REQUIRE(instance.short_ids()[index - 1] == message::compact_block::to_short_id(key, hash));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__short_id_key__nonce__differs)
+{
+    auto block = make_block();
+    const auto first = message::compact_block::factory(block, 1u);
+    const auto second = message::compact_block::factory(block, 2u);
+    BOOST_REQUIRE(first.short_id_key() != second.short_id_key());
+    BOOST_REQUIRE(first.short_ids() != second.short_ids());
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__reconstruct__all_known__complete)
+{
+    auto block = make_block();
+    const auto instance = message::compact_block::factory(block, 42u);
+    const chain::transaction::list known
+    {
+        chain::transaction(1, 9, {}, {}),
+        block.transactions()[3],
+        block.transactions()[1],
+        block.transactions()[2]
+    };
+
+    chain::block out;
+    message::get_block_transactions missing;
+    BOOST_REQUIRE(instance.reconstruct(out, missing, known));
+    BOOST_REQUIRE(missing.indexes().empty());
+    BOOST_REQUIRE(missing.block_hash() == block.hash());
+    BOOST_REQUIRE(out == block);
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__reconstruct__some_unknown__missing_differential_indexes)
+{
+    auto block = make_block();
+    const auto instance = message::compact_block::factory(block, 42u);
+    const chain::transaction::list known{ block.transactions()[2] };
+
+    chain::block out;
+    message::get_block_transactions missing;
+    BOOST_REQUIRE(instance.reconstruct(out, missing, known));
+    BOOST_REQUIRE(missing.indexes() == (std::vector<uint64_t>{ 1, 1 }));
+
+    const message::block_transactions response(block.hash(),
+        { block.transactions()[1], block.transactions()[3] });
+    BOOST_REQUIRE(message::compact_block::reconstruct(out, missing, response));
+    BOOST_REQUIRE(out == block);
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__reconstruct__response_size_mismatch__false)
+{
+    auto block = make_block();
+    const auto instance = message::compact_block::factory(block, 42u);
+
+    chain::block out;
+    message::get_block_transactions missing;
+    BOOST_REQUIRE(instance.reconstruct(out, missing, {}));
+    BOOST_REQUIRE_EQUAL(missing.indexes().size(), 3u);
+
+    const message::block_transactions response(block.hash(),
+        { block.transactions()[1] });
+    BOOST_REQUIRE(!message::compact_block::reconstruct(out, missing, response));
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__reconstruct__wrong_response_transaction__false)
+{
+    auto block = make_block();
+    const auto instance = message::compact_block::factory(block, 42u);
+
+    chain::block out;
+    message::get_block_transactions missing;
+    const chain::transaction::list known{ block.transactions()[2], block.transactions()[3] };
+    BOOST_REQUIRE(instance.reconstruct(out, missing, known));
+
+    const message::block_transactions response(block.hash(),
+        { chain::transaction(1, 9, {}, {}) });
+    BOOST_REQUIRE(!message::compact_block::reconstruct(out, missing, response));
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__reconstruct__duplicate_short_ids__false)
+{
+    auto block = make_block();
+    auto instance = message::compact_block::factory(block, 42u);
+    instance.short_ids()[1] = instance.short_ids()[0];
+
+    chain::block out;
+    message::get_block_transactions missing;
+    BOOST_REQUIRE(!instance.reconstruct(out, missing, block.transactions()));
+}
+
+BOOST_AUTO_TEST_CASE(compact_block__reconstruct__prefilled_index_out_of_range__false)
+{
+    auto block = make_block();
+    auto instance = message::compact_block::factory(block, 42u);
+    instance.transactions()[0].set_index(4);
+
+    chain::block out;
+    message::get_block_transactions missing;
+    BOOST_REQUIRE(!instance.reconstruct(out, missing, block.transactions()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
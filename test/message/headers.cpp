@@ -742,4 +742,96 @@ BOOST_AUTO_TEST_CASE(headers__is_sequential__disordered__false)
     BOOST_REQUIRE(!instance.is_sequential());
 }
 
+// Mainnet blocks 1 and 2, validated as successors of the genesis block state.
+static const auto mainnet_header1 = to_chunk(base16_literal("010000006fe28c0ab6f1b372c1a6a246ae63f74f931e8365e15a089c68d6190000000000982051fd1e4ba744bbbe680e1fee14677ba1a3c3540bf7b1cdb606e857233e0e61bc6649ffff001d01e36299"));
+static const auto mainnet_header2 = to_chunk(base16_literal("010000004860eb18bf1b1620e37e9490fc8a427514416fd75159ab86688e9a8300000000d5fdcc541e25de1c7a5addedf24858b8bb665c9f36ef744ee42c316022c90f9bb0bc6649ffff001d08d2bd61"));
+
+static chain::chain_state genesis_state(settings& settings, uint32_t bits=0x1d00ffff)
+{
+    chain::chain_state::data values;
+    values.height = 0;
+    values.hash = hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    values.bip9_bit0_hash = null_hash;
+    values.bip9_bit1_hash = null_hash;
+    values.bits.self = bits;
+    values.version.self = 1;
+    values.timestamp.self = 1231006505;
+    values.timestamp.retarget = 1231006505;
+    return chain::chain_state(std::move(values), {}, machine::rule_fork::retarget | machine::rule_fork::difficult, 0, settings);
+}
+
+static headers make_headers(const std::vector<data_chunk>& chunks)
+{
+    header::list elements;
+
+    for (const auto& chunk: chunks)
+        elements.push_back(header::factory(version::level::canonical, chunk));
+
+    return headers(std::move(elements));
+}
+
+BOOST_AUTO_TEST_CASE(headers__validate__valid_sequence__success_and_states_populated)
+{
+    settings settings(config::settings::mainnet);
+    const auto parent = genesis_state(settings);
+    auto instance = make_headers({ mainnet_header1, mainnet_header2 });
+    threadpool pool(2);
+    size_t index = 42;
+    BOOST_REQUIRE_EQUAL(instance.validate(parent, pool, settings, index), error::success);
+    BOOST_REQUIRE_EQUAL(index, 2u);
+    BOOST_REQUIRE(instance.is_sequential());
+
+    const auto& state = instance.elements().back().metadata.state;
+    BOOST_REQUIRE(state);
+    BOOST_REQUIRE_EQUAL(state->height(), 2u);
+    BOOST_REQUIRE(state->hash() == hash_literal("000000006a625f06636b8bb6ac7b960a8d03705d1ace08b1a19da3fdcc99ddbd"));
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(headers__validate__empty_pool__success)
+{
+    settings settings(config::settings::mainnet);
+    const auto parent = genesis_state(settings);
+    auto instance = make_headers({ mainnet_header1, mainnet_header2 });
+    threadpool pool;
+    size_t index;
+    BOOST_REQUIRE_EQUAL(instance.validate(parent, pool, settings, index), error::success);
+    BOOST_REQUIRE_EQUAL(index, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(headers__validate__unlinked__invalid_previous_block_at_index)
+{
+    settings settings(config::settings::mainnet);
+    const auto parent = genesis_state(settings);
+    auto instance = make_headers({ mainnet_header1, mainnet_header1 });
+    threadpool pool;
+    size_t index;
+    BOOST_REQUIRE_EQUAL(instance.validate(parent, pool, settings, index), error::invalid_previous_block);
+    BOOST_REQUIRE_EQUAL(index, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(headers__validate__insufficient_work__invalid_proof_of_work_at_index)
+{
+    settings settings(config::settings::mainnet);
+    const auto parent = genesis_state(settings);
+    auto instance = make_headers({ mainnet_header1, mainnet_header2 });
+    instance.elements()[1].set_nonce(0);
+    threadpool pool;
+    size_t index;
+    BOOST_REQUIRE_EQUAL(instance.validate(parent, pool, settings, index), error::invalid_proof_of_work);
+    BOOST_REQUIRE_EQUAL(index, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(headers__validate__unexpected_bits__incorrect_proof_of_work_at_index)
+{
+    settings settings(config::settings::mainnet);
+    const auto parent = genesis_state(settings, 0x1c00ffff);
+    auto instance = make_headers({ mainnet_header1, mainnet_header2 });
+    threadpool pool;
+    size_t index;
+    BOOST_REQUIRE_EQUAL(instance.validate(parent, pool, settings, index), error::incorrect_proof_of_work);
+    BOOST_REQUIRE_EQUAL(index, 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -462,4 +462,27 @@ BOOST_AUTO_TEST_CASE(inventory__reduce__matching_type__returns_matches)
     BOOST_REQUIRE(expected == result);
 }
 
+BOOST_AUTO_TEST_CASE(inventory__filter_unknown__known_entries__removed_in_order)
+{
+    const message::inventory_vector first(message::inventory_vector::type_id::transaction,
+        hash_literal("1111111111111111111111111111111111111111111111111111111111111111"));
+    const message::inventory_vector second(message::inventory_vector::type_id::block,
+        hash_literal("2222222222222222222222222222222222222222222222222222222222222222"));
+    const message::inventory_vector third(message::inventory_vector::type_id::transaction,
+        hash_literal("3333333333333333333333333333333333333333333333333333333333333333"));
+    const message::inventory_vector fourth(message::inventory_vector::type_id::witness_transaction,
+        hash_literal("4444444444444444444444444444444444444444444444444444444444444444"));
+
+    message::rolling_filter known(100, 0.000001, siphash_key(1, 2));
+    known.insert(second);
+    known.insert(message::inventory_vector(message::inventory_vector::type_id::transaction, fourth.hash()));
+
+    message::inventory instance({ first, second, third, fourth });
+    instance.filter_unknown(known);
+
+    const message::inventory_vector::list expected{ first, third };
+    BOOST_REQUIRE_EQUAL(instance.inventories().size(), expected.size());
+    BOOST_REQUIRE(instance.inventories() == expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,18 @@
 
 using namespace bc;
 
+static chain::block make_block(uint32_t count)
+{
+    chain::transaction::list transactions;
+    for (uint32_t locktime = 0; locktime < count; ++locktime)
+        transactions.push_back(chain::transaction(1, locktime, {}, {}));
+
+    chain::block block(chain::header(10u, null_hash, null_hash, 531234u,
+        6523454u, 68644u), transactions);
+    block.header().set_merkle(block.generate_merkle_root());
+    return block;
+}
+
 BOOST_AUTO_TEST_SUITE(merkle_block_tests)
 
 BOOST_AUTO_TEST_CASE(merkle_block__constructor_1__always__invalid)
@@ -625,4 +637,116 @@ BOOST_AUTO_TEST_CASE(merkle_block__operator_boolean_not_equals__differs__returns
     BOOST_REQUIRE(instance != expected);
 }
 
+BOOST_AUTO_TEST_CASE(merkle_block__constructor_matches__some__extracts_matches)
+{
+    auto block = make_block(5);
+    const message::merkle_block instance(block, { false, true, false, false, true });
+    BOOST_REQUIRE_EQUAL(instance.total_transactions(), 5u);
+
+    hash_list hashes;
+    message::merkle_block::indexes indexes;
+    BOOST_REQUIRE(instance.extract_matches(hashes, indexes));
+    BOOST_REQUIRE_EQUAL(hashes.size(), 2u);
+    BOOST_REQUIRE(hashes[0] == block.transactions()[1].hash());
+    BOOST_REQUIRE(hashes[1] == block.transactions()[4].hash());
+    BOOST_REQUIRE(indexes == (message::merkle_block::indexes{ 1, 4 }));
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__constructor_matches__none__root_only)
+{
+    auto block = make_block(5);
+    const message::merkle_block instance(block, { false, false, false, false, false });
+    BOOST_REQUIRE_EQUAL(instance.hashes().size(), 1u);
+    BOOST_REQUIRE(instance.hashes()[0] == block.header().merkle());
+    BOOST_REQUIRE(instance.flags() == data_chunk{ 0x00 });
+
+    hash_list hashes;
+    message::merkle_block::indexes indexes;
+    BOOST_REQUIRE(instance.extract_matches(hashes, indexes));
+    BOOST_REQUIRE(hashes.empty());
+    BOOST_REQUIRE(indexes.empty());
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__constructor_matches__all__extracts_all)
+{
+    auto block = make_block(7);
+    const message::merkle_block instance(block, std::vector<bool>(7, true));
+
+    hash_list hashes;
+    message::merkle_block::indexes indexes;
+    BOOST_REQUIRE(instance.extract_matches(hashes, indexes));
+    BOOST_REQUIRE(hashes == block.to_hashes());
+    BOOST_REQUIRE(indexes == (message::merkle_block::indexes{ 0, 1, 2, 3, 4, 5, 6 }));
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__constructor_matches__single_transaction__extracts_match)
+{
+    auto block = make_block(1);
+    const message::merkle_block instance(block, { true });
+
+    hash_list hashes;
+    message::merkle_block::indexes indexes;
+    BOOST_REQUIRE(instance.extract_matches(hashes, indexes));
+    BOOST_REQUIRE(hashes == block.to_hashes());
+    BOOST_REQUIRE(indexes == message::merkle_block::indexes{ 0 });
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__constructor_filter__matching_transaction__extracts_match)
+{
+    auto block = make_block(6);
+    message::bloom_filter filter(data_chunk(64, 0x00), 10, 42, message::bloom_filter::update_none);
+    filter.insert(block.transactions()[3].hash());
+    const message::merkle_block instance(block, filter);
+
+    hash_list hashes;
+    message::merkle_block::indexes indexes;
+    BOOST_REQUIRE(instance.extract_matches(hashes, indexes));
+    BOOST_REQUIRE(hashes == hash_list{ block.transactions()[3].hash() });
+    BOOST_REQUIRE(indexes == message::merkle_block::indexes{ 3 });
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract_matches__altered_hash__false)
+{
+    auto block = make_block(5);
+    message::merkle_block instance(block, { false, true, false, false, true });
+    instance.hashes()[0][0] ^= 0x01;
+
+    hash_list hashes;
+    message::merkle_block::indexes indexes;
+    BOOST_REQUIRE(!instance.extract_matches(hashes, indexes));
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract_matches__unused_hash__false)
+{
+    auto block = make_block(5);
+    message::merkle_block instance(block, { false, true, false, false, true });
+    instance.hashes().push_back(null_hash);
+
+    hash_list hashes;
+    message::merkle_block::indexes indexes;
+    BOOST_REQUIRE(!instance.extract_matches(hashes, indexes));
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract_matches__unused_flag_byte__false)
+{
+    auto block = make_block(5);
+    message::merkle_block instance(block, { false, true, false, false, true });
+    instance.flags().push_back(0x00);
+
+    hash_list hashes;
+    message::merkle_block::indexes indexes;
+    BOOST_REQUIRE(!instance.extract_matches(hashes, indexes));
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block__extract_matches__no_transactions__false)
+{
+    auto block = make_block(5);
+    message::merkle_block instance(block, { true, false, false, false, false });
+    instance.set_total_transactions(0);
+
+    hash_list hashes;
+    message::merkle_block::indexes indexes;
+    BOOST_REQUIRE(!instance.extract_matches(hashes, indexes));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -48,4 +48,84 @@ BOOST_AUTO_TEST_CASE(messages__variable_uint_size__eight_byte__expected)
     BOOST_REQUIRE_EQUAL(variable_uint_size(value), 9u);
 }
 
+BOOST_AUTO_TEST_CASE(messages__serialize__ping__framed_with_payload_checksum)
+{
+    static const uint32_t magic = 0xd9b4bef9;
+    static const auto version = version::level::maximum;
+    const ping packet(42);
+    const auto payload = packet.to_data(version);
+    const auto message = serialize(version, packet, magic);
+    BOOST_REQUIRE_EQUAL(message.size(), heading::satoshi_fixed_size() + payload.size());
+
+    const data_chunk head_data(message.begin(), message.begin() + heading::satoshi_fixed_size());
+    const auto head = heading::factory(head_data);
+    BOOST_REQUIRE_EQUAL(head.magic(), magic);
+    BOOST_REQUIRE_EQUAL(head.command(), ping::command);
+    BOOST_REQUIRE_EQUAL(head.payload_size(), payload.size());
+    BOOST_REQUIRE_EQUAL(head.checksum(), bitcoin_checksum(payload));
+    BOOST_REQUIRE(std::equal(payload.begin(), payload.end(), message.begin() + heading::satoshi_fixed_size()));
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialize__verack__empty_payload_checksum)
+{
+    const auto message = serialize(version::level::maximum, verack(), 0x0709110b);
+    BOOST_REQUIRE_EQUAL(message.size(), heading::satoshi_fixed_size());
+
+    const auto head = heading::factory(message);
+    BOOST_REQUIRE_EQUAL(head.command(), verack::command);
+    BOOST_REQUIRE_EQUAL(head.payload_size(), 0u);
+    BOOST_REQUIRE_EQUAL(head.checksum(), bitcoin_checksum(data_chunk{}));
+}
+
+// Reports one more payload byte than it writes.
+struct short_packet
+{
+    static const std::string command;
+
+    size_t serialized_size(uint32_t) const
+    {
+        return 5;
+    }
+
+    void to_data(uint32_t, writer& sink) const
+    {
+        sink.write_4_bytes_little_endian(42);
+    }
+};
+
+const std::string short_packet::command = "short";
+
+BOOST_AUTO_TEST_CASE(messages__serialize__payload_size_mismatch__empty)
+{
+    static const uint32_t magic = 0xd9b4bef9;
+    static const auto version = version::level::maximum;
+    BOOST_REQUIRE(serialize(version, short_packet(), magic).empty());
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialize__pool_payload_size_mismatch__empty)
+{
+    static const uint32_t magic = 0xd9b4bef9;
+    static const auto version = version::level::maximum;
+    buffer_pool pool;
+    BOOST_REQUIRE(serialize(version, short_packet(), magic, pool).empty());
+}
+
+BOOST_AUTO_TEST_CASE(messages__serialize__pool__equals_unpooled_and_recycled)
+{
+    static const uint32_t magic = 0xd9b4bef9;
+    static const auto version = version::level::maximum;
+    buffer_pool pool;
+    const ping packet(42);
+    const auto expected = serialize(version, packet, magic);
+
+    auto message = serialize(version, packet, magic, pool);
+    BOOST_REQUIRE(message == expected);
+    pool.release(std::move(message));
+
+    const auto reused = serialize(version, packet, magic, pool);
+    BOOST_REQUIRE(reused == expected);
+    BOOST_REQUIRE_EQUAL(pool.stats().hits, 1u);
+    BOOST_REQUIRE_EQUAL(pool.stats().misses, 1u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
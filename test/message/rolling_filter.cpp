@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(rolling_filter_tests)
+
+typedef inventory_vector::type_id type_id;
+static const siphash_key key(0x0706050403020100, 0x0f0e0d0c0b0a0908);
+
+static inventory_vector make_inventory(uint32_t value,
+    type_id type=type_id::transaction)
+{
+    return inventory_vector(type, sha256_hash(to_chunk(to_little_endian(value))));
+}
+
+BOOST_AUTO_TEST_CASE(rolling_filter__contains__empty__false)
+{
+    const rolling_filter instance(100, 0.001, key);
+    BOOST_REQUIRE(!instance.contains(make_inventory(42)));
+}
+
+BOOST_AUTO_TEST_CASE(rolling_filter__contains__inserted__true)
+{
+    rolling_filter instance(100, 0.001, key);
+    instance.insert(make_inventory(42));
+    BOOST_REQUIRE(instance.contains(make_inventory(42)));
+    BOOST_REQUIRE(!instance.contains(make_inventory(42, type_id::block)));
+}
+
+BOOST_AUTO_TEST_CASE(rolling_filter__contains__witness_type__ignores_witness_flag)
+{
+    rolling_filter instance(100, 0.001, key);
+    instance.insert(make_inventory(42, type_id::witness_transaction));
+    BOOST_REQUIRE(instance.contains(make_inventory(42, type_id::transaction)));
+}
+
+BOOST_AUTO_TEST_CASE(rolling_filter__contains__capacity__all_retained)
+{
+    rolling_filter instance(1000, 0.001, key);
+
+    for (uint32_t value = 0; value < 1000; ++value)
+        instance.insert(make_inventory(value));
+
+    for (uint32_t value = 0; value < 1000; ++value)
+        BOOST_REQUIRE(instance.contains(make_inventory(value)));
+}
+
+BOOST_AUTO_TEST_CASE(rolling_filter__contains__rolled_over__oldest_forgotten)
+{
+    rolling_filter instance(1000, 0.001, key);
+    const auto size = instance.size();
+
+    for (uint32_t value = 0; value < 4000; ++value)
+        instance.insert(make_inventory(value));
+
+    // Memory is fixed and the most recent capacity insertions are retained.
+    BOOST_REQUIRE_EQUAL(instance.size(), size);
+
+    for (uint32_t value = 3000; value < 4000; ++value)
+        BOOST_REQUIRE(instance.contains(make_inventory(value)));
+
+    // The first generations are cleared, leaving only false positives.
+    size_t positives = 0;
+
+    for (uint32_t value = 0; value < 1000; ++value)
+        if (instance.contains(make_inventory(value)))
+            ++positives;
+
+    BOOST_REQUIRE_LT(positives, 10u);
+}
+
+BOOST_AUTO_TEST_CASE(rolling_filter__reset__inserted__cleared)
+{
+    rolling_filter instance(100, 0.001, key);
+    instance.insert(make_inventory(42));
+    instance.reset();
+    BOOST_REQUIRE(!instance.contains(make_inventory(42)));
+}
+
+BOOST_AUTO_TEST_CASE(rolling_filter__hash_functions__false_positive_rate__optimal)
+{
+    BOOST_REQUIRE_EQUAL(rolling_filter(100, 0.5, key).hash_functions(), 1u);
+    BOOST_REQUIRE_EQUAL(rolling_filter(100, 0.001, key).hash_functions(), 10u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
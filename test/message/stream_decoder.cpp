@@ -0,0 +1,305 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::message;
+
+BOOST_AUTO_TEST_SUITE(stream_decoder_tests)
+
+static const uint32_t magic = 0xd9b4bef9;
+static const uint32_t version = version::level::maximum;
+
+// A ping followed by a verack (empty payload) followed by another ping.
+static data_chunk make_stream()
+{
+    return build_chunk(
+    {
+        message::serialize(version, ping(42), magic),
+        message::serialize(version, verack(), magic),
+        message::serialize(version, ping(24), magic)
+    });
+}
+
+struct recorder
+{
+    stream_decoder::handler handler()
+    {
+        return [this](const heading& head, data_slice payload)
+        {
+            commands.push_back(head.command());
+
+            if (head.command() == ping::command)
+            {
+                ping instance;
+                BOOST_REQUIRE(stream_decoder::parse(instance, version,
+                    payload));
+                nonces.push_back(instance.nonce());
+            }
+
+            return error::success;
+        };
+    }
+
+    string_list commands;
+    std::vector<uint64_t> nonces;
+};
+
+static void require_stream(const recorder& record)
+{
+    BOOST_REQUIRE_EQUAL(record.commands.size(), 3u);
+    BOOST_REQUIRE_EQUAL(record.commands[0], ping::command);
+    BOOST_REQUIRE_EQUAL(record.commands[1], verack::command);
+    BOOST_REQUIRE_EQUAL(record.commands[2], ping::command);
+    BOOST_REQUIRE_EQUAL(record.nonces.size(), 2u);
+    BOOST_REQUIRE_EQUAL(record.nonces[0], 42u);
+    BOOST_REQUIRE_EQUAL(record.nonces[1], 24u);
+}
+
+BOOST_AUTO_TEST_CASE(stream_decoder__decode__single_read__decodes_all_without_buffering)
+{
+    const auto stream = make_stream();
+    stream_decoder decoder(magic, version, true);
+    recorder record;
+    BOOST_REQUIRE_EQUAL(decoder.decode(stream, record.handler()), error::success);
+    BOOST_REQUIRE_EQUAL(decoder.buffered(), 0u);
+    require_stream(record);
+}
+
+BOOST_AUTO_TEST_CASE(stream_decoder__decode__byte_reads__decodes_all)
+{
+    const auto stream = make_stream();
+    stream_decoder decoder(magic, version, true);
+    recorder record;
+
+    for (auto it = stream.begin(); it != stream.end(); ++it)
+    {
+        const data_slice read(&*it, &*it + 1);
+        BOOST_REQUIRE_EQUAL(decoder.decode(read, record.handler()), error::success);
+    }
+
+    BOOST_REQUIRE_EQUAL(decoder.buffered(), 0u);
+    require_stream(record);
+}
+
+BOOST_AUTO_TEST_CASE(stream_decoder__decode__split_reads__retains_partial_message)
+{
+    const auto stream = make_stream();
+    const auto split = heading::satoshi_fixed_size() + 3;
+    stream_decoder decoder(magic, version, true);
+    recorder record;
+
+    const data_slice first(stream.data(), stream.data() + split);
+    BOOST_REQUIRE_EQUAL(decoder.decode(first, record.handler()), error::success);
+    BOOST_REQUIRE(record.commands.empty());
+    BOOST_REQUIRE_EQUAL(decoder.buffered(), 3u);
+
+    const data_slice second(stream.data() + split, stream.data() + stream.size());
+    BOOST_REQUIRE_EQUAL(decoder.decode(second, record.handler()), error::success);
+    BOOST_REQUIRE_EQUAL(decoder.buffered(), 0u);
+    require_stream(record);
+}
+
+BOOST_AUTO_TEST_CASE(stream_decoder__decode__wrong_magic__bad_stream)
+{
+    const auto stream = message::serialize(version, ping(42), magic + 1);
+    stream_decoder decoder(magic, version, true);
+    recorder record;
+    BOOST_REQUIRE_EQUAL(decoder.decode(stream, record.handler()), error::bad_stream);
+    BOOST_REQUIRE(record.commands.empty());
+}
+
+BOOST_AUTO_TEST_CASE(stream_decoder__decode__bad_checksum__bad_stream)
+{
+    auto stream = message::serialize(version, ping(42), magic);
+    stream.back() ^= 0xff;
+    stream_decoder decoder(magic, version, true);
+    recorder record;
+    BOOST_REQUIRE_EQUAL(decoder.decode(stream, record.handler()), error::bad_stream);
+    BOOST_REQUIRE(record.commands.empty());
+}
+
+BOOST_AUTO_TEST_CASE(stream_decoder__decode__oversized_payload__bad_stream)
+{
+    const auto size = heading::maximum_payload_size(version, false) + 1;
+    const heading head(magic, ping::command, safe_unsigned<uint32_t>(size), 0);
+    stream_decoder decoder(magic, version, false);
+    recorder record;
+    BOOST_REQUIRE_EQUAL(decoder.decode(head.to_data(), record.handler()), error::bad_stream);
+    BOOST_REQUIRE_EQUAL(decoder.buffered(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(stream_decoder__decode__handler_error__stops)
+{
+    const auto stream = make_stream();
+    stream_decoder decoder(magic, version, true);
+    size_t calls = 0;
+
+    const auto handler = [&calls](const heading&, data_slice)
+    {
+        return ++calls == 2 ? error::channel_stopped : error::success;
+    };
+
+    BOOST_REQUIRE_EQUAL(decoder.decode(stream, handler), error::channel_stopped);
+    BOOST_REQUIRE_EQUAL(calls, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(stream_decoder__reset__partial_message__discarded)
+{
+    const auto stream = make_stream();
+    stream_decoder decoder(magic, version, true);
+    recorder record;
+
+    const data_slice partial(stream.data(), stream.data() + 5);
+    BOOST_REQUIRE_EQUAL(decoder.decode(partial, record.handler()), error::success);
+    BOOST_REQUIRE_EQUAL(decoder.buffered(), 5u);
+
+    decoder.reset();
+    BOOST_REQUIRE_EQUAL(decoder.buffered(), 0u);
+    BOOST_REQUIRE_EQUAL(decoder.decode(stream, record.handler()), error::success);
+    require_stream(record);
+}
+
+BOOST_AUTO_TEST_CASE(stream_decoder__decode__split_small_message__capacity_retained)
+{
+    const auto stream = make_stream();
+    stream_decoder decoder(magic, version, true);
+    recorder record;
+
+    // The first ping is split, so it is handled from the buffer.
+    const data_slice first(stream.data(), stream.data() + 30);
+    const data_slice second(stream.data() + 30, stream.data() + stream.size());
+    BOOST_REQUIRE_EQUAL(decoder.decode(first, record.handler()), error::success);
+    BOOST_REQUIRE_EQUAL(decoder.decode(second, record.handler()), error::success);
+    require_stream(record);
+    BOOST_REQUIRE(decoder.capacity() != 0u);
+    BOOST_REQUIRE(decoder.capacity() <= buffer_pool::small_capacity);
+}
+
+BOOST_AUTO_TEST_CASE(stream_decoder__decode__split_large_message__capacity_released)
+{
+    const data_chunk payload(buffer_pool::small_capacity * 2, 0x42);
+    const auto message = message::serialize(version, filter_load(payload, 1, 2, 3), magic);
+    const auto split = message.size() / 2;
+    stream_decoder decoder(magic, version, true);
+    size_t calls = 0;
+
+    const auto handler = [&calls](const heading&, data_slice)
+    {
+        ++calls;
+        return error::success;
+    };
+
+    const data_slice first(message.data(), message.data() + split);
+    const data_slice second(message.data() + split, message.data() + message.size());
+    BOOST_REQUIRE_EQUAL(decoder.decode(first, handler), error::success);
+    BOOST_REQUIRE_EQUAL(decoder.decode(second, handler), error::success);
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+
+    // Without a pool a large buffer is freed rather than retained.
+    BOOST_REQUIRE_EQUAL(decoder.buffered(), 0u);
+    BOOST_REQUIRE_EQUAL(decoder.capacity(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(stream_decoder__decode__pool_large_split_message__buffer_recycled)
+{
+    const data_chunk payload(buffer_pool::small_capacity * 2, 0x42);
+    const auto message = message::serialize(version, filter_load(payload, 1, 2, 3), magic);
+    const auto split = message.size() / 2;
+    buffer_pool pool;
+    stream_decoder decoder(magic, version, true, pool);
+    size_t calls = 0;
+
+    const auto handler = [&calls](const heading&, data_slice)
+    {
+        ++calls;
+        return error::success;
+    };
+
+    // The first half fits the small class.
+    const data_slice first(message.data(), message.data() + split);
+    BOOST_REQUIRE_EQUAL(decoder.decode(first, handler), error::success);
+    BOOST_REQUIRE_EQUAL(pool.stats().misses, 1u);
+
+    // The second half moves the part to a transaction class buffer.
+    const data_slice second(message.data() + split, message.data() + message.size());
+    BOOST_REQUIRE_EQUAL(decoder.decode(second, handler), error::success);
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+    BOOST_REQUIRE_EQUAL(decoder.buffered(), 0u);
+
+    // Both buffers are returned once the message is handled.
+    const auto stats = pool.stats();
+    BOOST_REQUIRE_EQUAL(stats.misses, 2u);
+    BOOST_REQUIRE_EQUAL(stats.recycled, 2u);
+    BOOST_REQUIRE_EQUAL(stats.retained_bytes, buffer_pool::small_capacity + buffer_pool::transaction_capacity);
+}
+
+BOOST_AUTO_TEST_CASE(stream_decoder__decode__pool_stalled_large_payload__small_buffer)
+{
+    const uint32_t declared = max_block_weight;
+    const heading head(magic, block::command, declared, 0);
+    const auto stream = build_chunk({ head.to_data(), data_chunk{ 0x42 } });
+    buffer_pool pool;
+    stream_decoder decoder(magic, version, true, pool);
+    recorder record;
+
+    // Only the byte that arrived is buffered, not the declared payload.
+    BOOST_REQUIRE_EQUAL(decoder.decode(stream, record.handler()), error::success);
+    BOOST_REQUIRE_EQUAL(decoder.buffered(), 1u);
+    BOOST_REQUIRE_EQUAL(pool.stats().misses, 1u);
+
+    decoder.reset();
+    BOOST_REQUIRE_EQUAL(pool.stats().retained_bytes, buffer_pool::small_capacity);
+}
+
+BOOST_AUTO_TEST_CASE(stream_decoder__decode__pool_large_transaction__no_block_buffer)
+{
+    const data_chunk payload(200000, 0x42);
+    const heading head(magic, transaction::command, payload.size(), bitcoin_checksum(payload));
+    const auto stream = build_chunk({ head.to_data(), payload });
+    buffer_pool pool;
+    stream_decoder decoder(magic, version, true, pool);
+    size_t calls = 0;
+
+    const auto handler = [&calls](const heading&, data_slice)
+    {
+        ++calls;
+        return error::success;
+    };
+
+    // Deliver the message in reads of 20000 bytes.
+    for (size_t offset = 0; offset < stream.size(); offset += 20000)
+    {
+        const auto end = std::min(offset + 20000, stream.size());
+        const data_slice part(stream.data() + offset, stream.data() + end);
+        BOOST_REQUIRE_EQUAL(decoder.decode(part, handler), error::success);
+    }
+
+    // The buffer grows from the transaction class to an exact allocation,
+    // which is discarded once the message is handled.
+    const auto stats = pool.stats();
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+    BOOST_REQUIRE_EQUAL(stats.misses, 2u);
+    BOOST_REQUIRE_EQUAL(stats.discarded, 1u);
+    BOOST_REQUIRE_EQUAL(stats.retained_bytes, buffer_pool::transaction_capacity);
+    BOOST_REQUIRE_EQUAL(decoder.capacity(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
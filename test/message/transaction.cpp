@@ -642,4 +642,129 @@ BOOST_AUTO_TEST_CASE(transaction__operator_boolean_not_equals_2__differs__return
     BOOST_REQUIRE(alpha != beta);
 }
 
+#define WIRE_TX \
+"0100000001f08e44a96bfb5ae63eda1a6620adae37ee37ee4777fb0336e1bbbc" \
+"4de65310fc010000006a473044022050d8368cacf9bf1b8fb1f7cfd9aff63294" \
+"789eb1760139e7ef41f083726dadc4022067796354aba8f2e02363c5e510aa7e" \
+"2830b115472fb31de67d16972867f13945012103e589480b2f746381fca01a9b" \
+"12c517b7a482a203c8b2742985da0ac72cc078f2ffffffff02f0c9c467000000" \
+"001976a914d9d78e26df4e4601cf9b26d09c7b280ee764469f88ac80c4600f00" \
+"0000001976a9141ee32412020a324b93b1a1acfdfff6ab9ca8fac288ac000000" \
+"00"
+
+BOOST_AUTO_TEST_CASE(transaction__to_wire__always__equals_serialize)
+{
+    const auto raw_tx = to_chunk(base16_literal(WIRE_TX));
+    transaction instance;
+    BOOST_REQUIRE(instance.from_data(version::level::minimum, raw_tx));
+    const auto wire = instance.to_wire(version::level::minimum, 0x0709110b);
+    BOOST_REQUIRE(wire);
+    BOOST_REQUIRE(*wire == serialize(version::level::minimum, instance, 0x0709110b));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__to_wire__same_key__shared)
+{
+    const auto raw_tx = to_chunk(base16_literal(WIRE_TX));
+    transaction instance;
+    BOOST_REQUIRE(instance.from_data(version::level::minimum, raw_tx));
+    const auto first = instance.to_wire(version::level::minimum, 0x0709110b);
+    const auto second = instance.to_wire(version::level::minimum, 0x0709110b);
+    BOOST_REQUIRE(first == second);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__to_wire__different_version__reserialized)
+{
+    const auto raw_tx = to_chunk(base16_literal(WIRE_TX));
+    transaction instance;
+    BOOST_REQUIRE(instance.from_data(version::level::minimum, raw_tx));
+    const auto first = instance.to_wire(version::level::minimum, 0x0709110b);
+    const auto second = instance.to_wire(version::level::maximum, 0x0709110b);
+    BOOST_REQUIRE(first != second);
+    BOOST_REQUIRE(*second == serialize(version::level::maximum, instance, 0x0709110b));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__to_wire__different_magic__reserialized)
+{
+    const auto raw_tx = to_chunk(base16_literal(WIRE_TX));
+    transaction instance;
+    BOOST_REQUIRE(instance.from_data(version::level::minimum, raw_tx));
+    const auto first = instance.to_wire(version::level::minimum, 0x0709110b);
+    const auto second = instance.to_wire(version::level::minimum, 0xd9b4bef9);
+    BOOST_REQUIRE(first != second);
+    BOOST_REQUIRE(*second == serialize(version::level::minimum, instance, 0xd9b4bef9));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__to_wire__from_data__reserialized)
+{
+    const auto raw_tx = to_chunk(base16_literal(WIRE_TX));
+    transaction instance;
+    const auto empty = instance.to_wire(version::level::minimum, 0x0709110b);
+    BOOST_REQUIRE(instance.from_data(version::level::minimum, raw_tx));
+    const auto wire = instance.to_wire(version::level::minimum, 0x0709110b);
+    BOOST_REQUIRE(empty != wire);
+    BOOST_REQUIRE(*wire == serialize(version::level::minimum, instance, 0x0709110b));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__to_wire__mutable_input_witness__reserialized)
+{
+    const auto raw_tx = to_chunk(base16_literal(WIRE_TX));
+    transaction instance;
+    BOOST_REQUIRE(instance.from_data(version::level::minimum, raw_tx));
+    const auto first = instance.to_wire(version::level::minimum, 0x0709110b);
+    instance.inputs().front().set_witness(chain::witness(data_stack{ { 0x42 } }));
+    const auto second = instance.to_wire(version::level::minimum, 0x0709110b);
+    BOOST_REQUIRE(first != second);
+    BOOST_REQUIRE(*second == serialize(version::level::minimum, instance, 0x0709110b));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__to_wire__witness_excluded__matches_stripped)
+{
+    const auto raw_tx = to_chunk(base16_literal(WIRE_TX));
+    transaction instance;
+    BOOST_REQUIRE(instance.from_data(version::level::minimum, raw_tx));
+    instance.inputs().front().set_witness(chain::witness(data_stack{ { 0x42 } }));
+    const auto witness = instance.to_wire(version::level::minimum, 0x0709110b);
+    const auto stripped = instance.to_wire(version::level::minimum, 0x0709110b, false);
+    BOOST_REQUIRE(*witness != *stripped);
+
+    // The stripped encoding frames the original (non-witness) transaction.
+    const auto original = transaction::factory(version::level::minimum, raw_tx);
+    BOOST_REQUIRE(*stripped == serialize(version::level::minimum, original, 0x0709110b));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__to_wire__chain_setter__reserialized)
+{
+    transaction instance(1, 0, {}, {});
+    const auto first = instance.to_wire(version::level::minimum, 0x0709110b);
+    static_cast<chain::transaction&>(instance).set_locktime(42);
+    const auto second = instance.to_wire(version::level::minimum, 0x0709110b);
+    BOOST_REQUIRE(first != second);
+    BOOST_REQUIRE(*second == serialize(version::level::minimum, instance, 0x0709110b));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__to_wire__set_outputs__reserialized)
+{
+    transaction instance(1, 0, {}, {});
+    const auto first = instance.to_wire(version::level::minimum, 0x0709110b);
+    instance.set_outputs({ chain::output(42, chain::script()) });
+    const auto second = instance.to_wire(version::level::minimum, 0x0709110b);
+    BOOST_REQUIRE(first != second);
+    BOOST_REQUIRE(*second == serialize(version::level::minimum, instance, 0x0709110b));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__to_wire__chain_assignment__reserialized)
+{
+    transaction instance(1, 0, {}, {});
+    const auto first = instance.to_wire(version::level::minimum, 0x0709110b);
+    static_cast<chain::transaction&>(instance) = chain::transaction(1, 42, {}, {});
+    const auto second = instance.to_wire(version::level::minimum, 0x0709110b);
+    BOOST_REQUIRE(first != second);
+    BOOST_REQUIRE(*second == serialize(version::level::minimum, instance, 0x0709110b));
+}
+
+BOOST_AUTO_TEST_CASE(transaction__chain_base__not_polymorphic)
+{
+    BOOST_REQUIRE(!std::is_polymorphic<chain::transaction>::value);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
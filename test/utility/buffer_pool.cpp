@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(buffer_pool_tests)
+
+BOOST_AUTO_TEST_CASE(buffer_pool__acquire__empty_pool__miss)
+{
+    buffer_pool instance;
+    const auto buffer = instance.acquire(100);
+    BOOST_REQUIRE(buffer.empty());
+    BOOST_REQUIRE_GE(buffer.capacity(), buffer_pool::small_capacity);
+
+    const auto stats = instance.stats();
+    BOOST_REQUIRE_EQUAL(stats.hits, 0u);
+    BOOST_REQUIRE_EQUAL(stats.misses, 1u);
+    BOOST_REQUIRE_EQUAL(stats.hit_rate(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__acquire__released__hit_same_buffer)
+{
+    buffer_pool instance;
+    auto buffer = instance.acquire(1000);
+    buffer.resize(1000, 42);
+    const auto data = buffer.data();
+    instance.release(std::move(buffer));
+
+    auto stats = instance.stats();
+    BOOST_REQUIRE_EQUAL(stats.recycled, 1u);
+    BOOST_REQUIRE_EQUAL(stats.retained, 1u);
+    BOOST_REQUIRE_EQUAL(stats.retained_bytes, buffer_pool::small_capacity);
+
+    const auto reused = instance.acquire(10);
+    BOOST_REQUIRE(reused.empty());
+    BOOST_REQUIRE(reused.data() == data);
+
+    stats = instance.stats();
+    BOOST_REQUIRE_EQUAL(stats.hits, 1u);
+    BOOST_REQUIRE_EQUAL(stats.retained, 0u);
+    BOOST_REQUIRE_EQUAL(stats.retained_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(stats.hit_rate(), 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__acquire__transaction_size__transaction_class)
+{
+    buffer_pool instance;
+    instance.release(instance.acquire(10));
+    const auto buffer = instance.acquire(buffer_pool::small_capacity + 1);
+    BOOST_REQUIRE_GE(buffer.capacity(), buffer_pool::transaction_capacity);
+
+    // The small buffer does not satisfy a transaction.
+    BOOST_REQUIRE_EQUAL(instance.stats().misses, 2u);
+    BOOST_REQUIRE_EQUAL(instance.stats().retained, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__acquire__above_transaction_class__exact_not_retained)
+{
+    buffer_pool instance;
+    auto buffer = instance.acquire(buffer_pool::transaction_capacity + 1);
+    BOOST_REQUIRE_EQUAL(buffer.capacity(), buffer_pool::transaction_capacity + 1);
+    instance.release(std::move(buffer));
+
+    const auto stats = instance.stats();
+    BOOST_REQUIRE_EQUAL(stats.misses, 1u);
+    BOOST_REQUIRE_EQUAL(stats.discarded, 1u);
+    BOOST_REQUIRE_EQUAL(stats.retained, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__acquire__above_half_block_class__block_class)
+{
+    buffer_pool instance;
+    auto buffer = instance.acquire(buffer_pool::block_capacity / 2 + 1);
+    BOOST_REQUIRE_EQUAL(buffer.capacity(), buffer_pool::block_capacity);
+    instance.release(std::move(buffer));
+
+    const auto stats = instance.stats();
+    BOOST_REQUIRE_EQUAL(stats.recycled, 1u);
+    BOOST_REQUIRE_EQUAL(stats.retained_bytes, buffer_pool::block_capacity);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__release__larger_than_block__discarded)
+{
+    buffer_pool instance;
+    auto buffer = instance.acquire(buffer_pool::block_capacity + 1);
+    BOOST_REQUIRE_GE(buffer.capacity(), buffer_pool::block_capacity + 1);
+    instance.release(std::move(buffer));
+
+    const auto stats = instance.stats();
+    BOOST_REQUIRE_EQUAL(stats.discarded, 1u);
+    BOOST_REQUIRE_EQUAL(stats.retained, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__release__smaller_than_small__discarded)
+{
+    buffer_pool instance;
+    instance.release(data_chunk(10));
+    BOOST_REQUIRE_EQUAL(instance.stats().discarded, 1u);
+    BOOST_REQUIRE_EQUAL(instance.stats().retained, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__release__oversized_for_small_class__discarded)
+{
+    buffer_pool instance;
+    data_chunk buffer;
+    buffer.reserve(buffer_pool::transaction_capacity - 1);
+    instance.release(std::move(buffer));
+    BOOST_REQUIRE_EQUAL(instance.stats().discarded, 1u);
+    BOOST_REQUIRE_EQUAL(instance.stats().retained, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__release__oversized_for_transaction_class__discarded)
+{
+    buffer_pool instance;
+    data_chunk buffer;
+    buffer.reserve(buffer_pool::block_capacity - 1);
+    instance.release(std::move(buffer));
+    BOOST_REQUIRE_EQUAL(instance.stats().discarded, 1u);
+    BOOST_REQUIRE_EQUAL(instance.stats().retained_bytes, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__release__block_class_full__discarded)
+{
+    buffer_pool instance;
+    std::vector<data_chunk> buffers;
+
+    for (size_t index = 0; index < 5; ++index)
+        buffers.push_back(instance.acquire(buffer_pool::block_capacity));
+
+    for (auto& buffer: buffers)
+        instance.release(std::move(buffer));
+
+    const auto stats = instance.stats();
+    BOOST_REQUIRE_EQUAL(stats.recycled, 4u);
+    BOOST_REQUIRE_EQUAL(stats.discarded, 1u);
+    BOOST_REQUIRE_EQUAL(stats.retained_bytes, 4 * buffer_pool::block_capacity);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__clear__retained__freed)
+{
+    buffer_pool instance;
+    instance.release(instance.acquire(10));
+    instance.clear();
+
+    const auto stats = instance.stats();
+    BOOST_REQUIRE_EQUAL(stats.retained, 0u);
+    BOOST_REQUIRE_EQUAL(stats.retained_bytes, 0u);
+    BOOST_REQUIRE_EQUAL(stats.recycled, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_pool__acquire_release__concurrent__consistent)
+{
+    static const size_t threads = 4;
+    static const size_t cycles = 1000;
+    buffer_pool instance;
+    std::vector<std::thread> workers;
+
+    for (size_t thread = 0; thread < threads; ++thread)
+    {
+        workers.emplace_back([&instance]()
+        {
+            for (size_t cycle = 0; cycle < cycles; ++cycle)
+            {
+                auto buffer = instance.acquire(100);
+                buffer.resize(100);
+                instance.release(std::move(buffer));
+            }
+        });
+    }
+
+    for (auto& worker: workers)
+        worker.join();
+
+    const auto stats = instance.stats();
+    BOOST_REQUIRE_EQUAL(stats.hits + stats.misses, threads * cycles);
+    BOOST_REQUIRE_EQUAL(stats.recycled, threads * cycles);
+    BOOST_REQUIRE_LE(stats.misses, threads);
+    BOOST_REQUIRE_EQUAL(stats.retained, stats.misses);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
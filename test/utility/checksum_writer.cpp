@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(checksum_writer_tests)
+
+BOOST_AUTO_TEST_CASE(checksum_writer__checksum__written__matches_bitcoin_checksum)
+{
+    data_chunk data(1 + 2 + 4 + 8 + 4 + 3 + 12 + 6);
+    checksum_writer writer(data.data(), data.data() + data.size());
+    writer.write_byte(0x80);
+    writer.write_2_bytes_little_endian(0x8040);
+    writer.write_4_bytes_little_endian(0x80402010);
+    writer.write_8_bytes_little_endian(0x8040201011223344);
+    writer.write_4_bytes_big_endian(0x80402010);
+    writer.write_variable_little_endian(1234);
+    writer.write_string("ping", 12);
+    writer.write_string("hello");
+    BOOST_REQUIRE(writer);
+    BOOST_REQUIRE_EQUAL(writer.size(), data.size());
+    BOOST_REQUIRE_EQUAL(writer.checksum(), bitcoin_checksum(data));
+
+    data_chunk expected(data.size());
+    auto serial = make_unsafe_serializer(expected.begin());
+    serial.write_byte(0x80);
+    serial.write_2_bytes_little_endian(0x8040);
+    serial.write_4_bytes_little_endian(0x80402010);
+    serial.write_8_bytes_little_endian(0x8040201011223344);
+    serial.write_4_bytes_big_endian(0x80402010);
+    serial.write_variable_little_endian(1234);
+    serial.write_string("ping", 12);
+    serial.write_string("hello");
+    BOOST_REQUIRE(data == expected);
+}
+
+BOOST_AUTO_TEST_CASE(checksum_writer__checksum__empty__matches_bitcoin_checksum)
+{
+    data_chunk data;
+    checksum_writer writer(data.data(), data.data());
+    BOOST_REQUIRE(writer);
+    BOOST_REQUIRE_EQUAL(writer.checksum(), bitcoin_checksum(data));
+}
+
+BOOST_AUTO_TEST_CASE(checksum_writer__write_bytes__overflow__invalid)
+{
+    data_chunk data(3);
+    checksum_writer writer(data.data(), data.data() + data.size());
+    writer.write_2_bytes_little_endian(42);
+    BOOST_REQUIRE(writer);
+    writer.write_2_bytes_little_endian(42);
+    BOOST_REQUIRE(!writer);
+    BOOST_REQUIRE_EQUAL(writer.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(checksum_writer__append__written__matches_in_place)
+{
+    const auto prefix = to_chunk(base16_literal("0102"));
+    data_chunk data(prefix);
+    checksum_writer writer(data, 4 + 5);
+    writer.write_4_bytes_little_endian(0x80402010);
+    writer.write_string("ping", 5);
+    BOOST_REQUIRE(writer);
+    BOOST_REQUIRE_EQUAL(writer.size(), 4u + 5u);
+    BOOST_REQUIRE_EQUAL(data.size(), prefix.size() + 4u + 5u);
+
+    data_chunk expected(4 + 5);
+    checksum_writer in_place(expected.data(), expected.data() + expected.size());
+    in_place.write_4_bytes_little_endian(0x80402010);
+    in_place.write_string("ping", 5);
+    BOOST_REQUIRE(std::equal(expected.begin(), expected.end(), data.begin() + prefix.size()));
+    BOOST_REQUIRE_EQUAL(writer.checksum(), bitcoin_checksum(expected));
+}
+
+BOOST_AUTO_TEST_CASE(checksum_writer__append__overflow__invalid)
+{
+    data_chunk data;
+    checksum_writer writer(data, 3);
+    writer.write_4_bytes_little_endian(42);
+    BOOST_REQUIRE(!writer);
+    BOOST_REQUIRE(data.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
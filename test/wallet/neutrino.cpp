@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::wallet;
+
+BOOST_AUTO_TEST_SUITE(neutrino_tests)
+
+// Vectors from BIP158 (testnet genesis block).
+
+#define TESTNET_GENESIS_BLOCK \
+"0100000000000000000000000000000000000000000000000000000000000000000000003ba3edfd7a7b12b27ac72c3e67768f617fc81bc3888a51323a9fb8aa4b1e5e4adae5494dffff001d1aa4ae18" \
+"0101000000010000000000000000000000000000000000000000000000000000000000000000ffffffff4d04ffff001d0104455468652054696d65732030332f4a616e2f32303039204368616e63656c6c6f72206f6e206272696e6b206f66207365636f6e64206261696c6f757420666f722062616e6b73ffffffff0100f2052a01000000434104678afdb0fe5548271967f1a67130b7105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef38c4f35504e51ec112de5c384df7ba0b8d578a4c702b6bf11d5fac00000000"
+
+static chain::block testnet_genesis()
+{
+    data_chunk data;
+    BOOST_REQUIRE(decode_base16(data, TESTNET_GENESIS_BLOCK));
+    return chain::block::factory(data);
+}
+
+BOOST_AUTO_TEST_CASE(neutrino__compute_filter__testnet_genesis__expected)
+{
+    auto block = testnet_genesis();
+    BOOST_REQUIRE(block.hash() == hash_literal("000000000933ea01ad0ee984209779baaec3ced90fa3f408719526f8d77f4943"));
+
+    data_chunk filter;
+    BOOST_REQUIRE(compute_filter(block, filter));
+    BOOST_REQUIRE_EQUAL(encode_base16(filter), "019dfca8");
+}
+
+BOOST_AUTO_TEST_CASE(neutrino__compute_filter_header__testnet_genesis__expected)
+{
+    const auto filter = to_chunk(base16_literal("019dfca8"));
+    const auto header = compute_filter_header(null_hash, filter);
+    BOOST_REQUIRE(header == hash_literal("21584579b7eb08997773e5aeff3a7f932700042d0ed2a6129012b7d7ae81b750"));
+}
+
+BOOST_AUTO_TEST_CASE(neutrino__compute_filter__missing_prevout__false)
+{
+    auto block = testnet_genesis();
+    auto transactions = block.transactions();
+    transactions.push_back(chain::transaction(1, 0,
+        { chain::input(chain::output_point(null_hash, 0), {}, 0) }, {}));
+    block.set_transactions(std::move(transactions));
+
+    data_chunk filter;
+    BOOST_REQUIRE(!compute_filter(block, filter));
+}
+
+BOOST_AUTO_TEST_CASE(neutrino__compute_filter__prevout_script__matches)
+{
+    auto block = testnet_genesis();
+    const chain::script prevout_script(chain::script::to_pay_key_hash_pattern(null_short_hash));
+    const chain::script null_data(chain::script::to_pay_null_data_pattern(to_chunk(base16_literal("42"))));
+
+    chain::transaction spend(1, 0,
+        { chain::input(chain::output_point(null_hash, 0), {}, 0) },
+        { chain::output(0, null_data) });
+    spend.inputs().front().previous_output().metadata.cache = chain::output(42, prevout_script);
+
+    auto transactions = block.transactions();
+    transactions.push_back(spend);
+    block.set_transactions(std::move(transactions));
+
+    data_chunk filter;
+    BOOST_REQUIRE(compute_filter(block, filter));
+    BOOST_REQUIRE_EQUAL(filter.front(), 2u);
+    BOOST_REQUIRE(match_filter(block.hash(), filter, prevout_script));
+    BOOST_REQUIRE(!match_filter(block.hash(), filter, null_data));
+}
+
+BOOST_AUTO_TEST_CASE(neutrino__match_filter__coinbase_script__true)
+{
+    auto block = testnet_genesis();
+    data_chunk filter;
+    BOOST_REQUIRE(compute_filter(block, filter));
+    const auto& script = block.transactions().front().outputs().front().script();
+    BOOST_REQUIRE(match_filter(block.hash(), filter, script));
+}
+
+BOOST_AUTO_TEST_CASE(neutrino__match_filter__other_script__false)
+{
+    auto block = testnet_genesis();
+    data_chunk filter;
+    BOOST_REQUIRE(compute_filter(block, filter));
+    const chain::script other(chain::script::to_pay_key_hash_pattern(null_short_hash));
+    BOOST_REQUIRE(!match_filter(block.hash(), filter, other));
+}
+
+BOOST_AUTO_TEST_CASE(neutrino__match_filter__scripts_including_coinbase_script__true)
+{
+    auto block = testnet_genesis();
+    data_chunk filter;
+    BOOST_REQUIRE(compute_filter(block, filter));
+
+    const auto& script = block.transactions().front().outputs().front().script();
+    const chain::script other(chain::script::to_pay_key_hash_pattern(null_short_hash));
+    const data_stack scripts{ other.to_data(false), script.to_data(false) };
+    BOOST_REQUIRE(match_filter(block.hash(), filter, scripts));
+    BOOST_REQUIRE(!match_filter(block.hash(), filter, data_stack{ other.to_data(false) }));
+}
+
+BOOST_AUTO_TEST_CASE(neutrino__match_filter__wrong_block_hash__false)
+{
+    auto block = testnet_genesis();
+    data_chunk filter;
+    BOOST_REQUIRE(compute_filter(block, filter));
+    const auto& script = block.transactions().front().outputs().front().script();
+    BOOST_REQUIRE(!match_filter(null_hash, filter, script));
+}
+
+BOOST_AUTO_TEST_CASE(neutrino__match_filter__non_minimal_count__false)
+{
+    auto block = testnet_genesis();
+    data_chunk filter;
+    BOOST_REQUIRE(compute_filter(block, filter));
+    const auto& script = block.transactions().front().outputs().front().script();
+
+    // The same count and set with the count encoded in three bytes.
+    data_chunk non_minimal{ varint_two_bytes, filter.front(), 0x00 };
+    non_minimal.insert(non_minimal.end(), filter.begin() + 1, filter.end());
+    BOOST_REQUIRE(!match_filter(block.hash(), non_minimal, script));
+}
+
+BOOST_AUTO_TEST_SUITE_END()